@@ -0,0 +1,104 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "assignment.hpp"
+
+// Allocator drawing from a shared memory resource and keeping it alive. Objects made with
+// std::allocate_shared store a copy in their control block, so the resource outlives them.
+template <typename T>
+class SharedResourceAllocator {
+public:
+    using value_type = T;
+
+    explicit SharedResourceAllocator(std::shared_ptr<std::pmr::memory_resource> resource)
+        : resource(std::move(resource)) {}
+
+    template <typename U>
+    SharedResourceAllocator(const SharedResourceAllocator<U>& other) : resource(other.resource) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        resource->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    bool operator==(const SharedResourceAllocator<U>& other) const { return resource == other.resource; }
+    template <typename U>
+    bool operator!=(const SharedResourceAllocator<U>& other) const { return resource != other.resource; }
+
+    std::shared_ptr<std::pmr::memory_resource> resource;
+};
+
+// Monotonic arena for a batch of loaded assignments. Each assignment and its control block
+// come from a few large blocks, which are released together once the last assignment made
+// from the arena is gone, so a single survivor pins them all. Stores that live on and are
+// edited (the daemon's cache, the interactive session) move their assignments to the heap
+// first. Not thread-safe: allocate from one thread at a time.
+class AssignmentArena {
+public:
+    // `initialBytes` sizes the first block; later blocks grow geometrically
+    explicit AssignmentArena(std::size_t initialBytes = 16 * 1024);
+
+    template <typename... Args>
+    std::shared_ptr<Assignment> make(Args&&... args) {
+        return std::allocate_shared<Assignment>(SharedResourceAllocator<Assignment>(resource), std::forward<Args>(args)...);
+    }
+
+    // True while assignments made from the arena are alive
+    bool pinned() const;
+
+    // Suggested first block size for assignments parsed from `fileBytes` of JSON
+    static std::size_t initialBytesForFile(std::size_t fileBytes);
+
+    // Move each assignment into its own heap allocation, releasing the arenas they came from
+    static void moveToHeap(std::vector<std::shared_ptr<Assignment>>& assignments);
+
+private:
+    std::shared_ptr<std::pmr::memory_resource> resource;
+};
+
+// Scratch memory for one scheduler run. Each thread keeps one block, grown to the peak
+// of earlier runs, so repeated runs on a thread allocate nothing from the heap. Everything
+// allocated from resource() must be released before the arena is destroyed.
+class ScratchArena {
+public:
+    ScratchArena();
+
+    // Grows the thread's block when this run needed more than it had
+    ~ScratchArena();
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    std::pmr::memory_resource* resource();
+
+    // Size of the calling thread's reusable block
+    static std::size_t threadBlockSize();
+
+private:
+    // Upstream for blocks beyond the thread's block, counting what it hands out
+    class OverflowResource : public std::pmr::memory_resource {
+    public:
+        std::size_t allocated = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    bool ownsThreadBlock = false; // False for an arena nested inside another on the same thread
+    OverflowResource overflow;
+    std::optional<std::pmr::monotonic_buffer_resource> arena;
+};
+
+#endif // ARENA_HPP
@@ -3,10 +3,16 @@
 
 #include <string>
 #include <iostream>
+#include <cstdint>
+#include "subjecttable.hpp"
+
+// Persistent identifier of an assignment; 0 means "not assigned yet"
+using AssignmentId = std::uint64_t;
 
 class Assignment {
 private:
-    std::string subject;
+    AssignmentId id; // Stable identity across saves, assigned by the AssignmentStore
+    SubjectId subjectId; // Interned subject name
     std::string name;
     int deadline; // Remaining days to complete the assignment
     int duration; // Total required hours to complete the assignment
@@ -40,6 +46,10 @@ public:
     // Destructor
     ~Assignment();
 
+    // Setter and Getter for the persistent id
+    void setId(AssignmentId id);
+    AssignmentId getId() const;
+
     // Setters and Getters for Priority
     void setPriority(int priority);
     int getPriority() const;
@@ -50,6 +60,7 @@ public:
 
     // Getters for private members
     const std::string& getSubject() const;
+    SubjectId getSubjectId() const;
     const std::string& getName() const;
     int getDeadline() const;
     int getDuration() const;
@@ -61,6 +72,10 @@ public:
 
     // Display function
     void display() const;
+
+    // Whether imported fields make a usable assignment: a group of at least one member and
+    // no negative deadline, duration or size
+    static bool validFields(int deadline, int duration, int size, int groupSize);
 };
 
 #endif // ASSIGNMENT_HPP
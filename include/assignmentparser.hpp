@@ -0,0 +1,44 @@
+#ifndef ASSIGNMENTPARSER_HPP
+#define ASSIGNMENTPARSER_HPP
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include "assignment.hpp"
+
+// Schema-specialized parser for assignment files: a JSON array of objects with exactly the
+// fields subject, name, deadline, duration, weight, size, group_work, group_size and an
+// optional id. It scans the bytes directly and rejects anything outside that shape
+// (unknown or repeated keys, fractional integers, malformed JSON, ...) so callers can
+// fall back to the general nlohmann parser.
+namespace AssignmentParser {
+    // Fields of one parsed assignment object
+    struct Record {
+        std::string_view subject; // Views into the input, or into parser scratch when the
+        std::string_view name;    // string had escapes; valid only inside the callback
+        std::string_view user;    // Only set by parseLine
+        bool subjectEscaped = false;
+        bool nameEscaped = false;
+        bool userEscaped = false;
+        int deadline = 0;
+        int duration = 0;
+        float weight = 0.0f;
+        int size = 0;
+        bool groupWork = false;
+        int groupSize = 0;
+        AssignmentId id = 0;
+    };
+
+    using RecordCallback = std::function<void(const Record&)>;
+
+    // Parse a whole assignment array, calling `onRecord` for each object in order.
+    // Returns false as soon as the input leaves the supported shape; records already
+    // reported before that point should then be discarded.
+    bool parseArray(std::string_view text, const RecordCallback& onRecord);
+
+    // Parse one NDJSON import line: a single assignment object that also carries a "user"
+    // field. Calls `onRecord` once and returns true, or returns false without calling it.
+    bool parseLine(std::string_view line, const RecordCallback& onRecord);
+}
+
+#endif // ASSIGNMENTPARSER_HPP
@@ -0,0 +1,24 @@
+#ifndef ASSIGNMENTQUERIES_HPP
+#define ASSIGNMENTQUERIES_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "assignment.hpp"
+
+// Ordered and range queries over a list of assignments.
+// Results keep the original list order among equal keys.
+namespace AssignmentQueries {
+    using AssignmentPtr = std::shared_ptr<Assignment>;
+
+    // The k assignments with the soonest deadlines, soonest first
+    std::vector<AssignmentPtr> soonestDeadlines(const std::vector<AssignmentPtr>& assignments, std::size_t k);
+
+    // The k assignments with the longest durations, longest first
+    std::vector<AssignmentPtr> longestDurations(const std::vector<AssignmentPtr>& assignments, std::size_t k);
+
+    // Assignments due within the given number of days, soonest first
+    std::vector<AssignmentPtr> dueWithin(const std::vector<AssignmentPtr>& assignments, int days);
+}
+
+#endif // ASSIGNMENTQUERIES_HPP
@@ -0,0 +1,44 @@
+#ifndef ASSIGNMENTRENDERER_HPP
+#define ASSIGNMENTRENDERER_HPP
+
+#include <ostream>
+#include <string_view>
+#include "assignment.hpp"
+#include "outputbuffer.hpp"
+
+// Formats assignment rows into one reusable buffer and writes it out in batches
+class AssignmentRenderer {
+public:
+    enum class Layout {
+        Detailed, // One "Field: value" line per field, rows separated by a rule
+        Table,    // One fixed-width line per assignment under a header
+        Tsv,      // Tab-separated values with a header line
+        Ndjson    // One JSON object per line
+    };
+
+    // Parse a layout name (detailed, table, tsv, ndjson); throws std::invalid_argument
+    static Layout parseLayout(std::string_view name);
+
+    AssignmentRenderer(std::ostream& out, Layout layout);
+
+    // Human-readable text such as titles and notices; machine-readable layouts omit it
+    void text(std::string_view message);
+
+    // Render one assignment
+    void row(const Assignment& assignment);
+
+    // Write everything rendered so far
+    void finish();
+
+    // Append the detailed "Field: value" block of one assignment
+    static void appendDetails(OutputBuffer& buffer, const Assignment& assignment);
+
+private:
+    Layout layout;
+    OutputBuffer buffer;
+    bool headerWritten = false;
+
+    void header();
+};
+
+#endif // ASSIGNMENTRENDERER_HPP
@@ -0,0 +1,108 @@
+#ifndef ASSIGNMENTSTORE_HPP
+#define ASSIGNMENTSTORE_HPP
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "assignment.hpp"
+#include "subjecttable.hpp"
+
+// A user's assignments together with secondary indices kept up to date on every change.
+// Every stored assignment carries a unique persistent id; lookups, updates and deletes by id
+// are O(1) in the list. Deletes leave a tombstone so the list keeps its order; tombstones are
+// compacted away once they make up half the list, or on the next read of the list or a posting.
+// The indexed fields (deadline, duration, subject) must not change while an assignment is
+// stored: replace the assignment through update() instead.
+class AssignmentStore {
+public:
+    using AssignmentPtr = std::shared_ptr<Assignment>;
+
+    // Index keys pair the sort key with the assignment id, so equal keys are ordered by id
+    using IndexKey = std::pair<int, AssignmentId>;
+    struct BiggestFirst {
+        bool operator()(const IndexKey& a, const IndexKey& b) const {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        }
+    };
+    using DeadlineIndex = std::map<IndexKey, AssignmentPtr>;
+    using DurationIndex = std::map<IndexKey, AssignmentPtr, BiggestFirst>;
+
+    // Posting list of one subject with its running aggregates
+    struct SubjectPosting {
+        std::vector<AssignmentPtr> assignments; // In insertion order
+        int totalHours = 0;                     // Sum of the assignments' durations
+        std::size_t removed = 0;                // Tombstones in assignments, none once returned by the store
+    };
+    using SubjectIndex = std::unordered_map<SubjectId, SubjectPosting>;
+
+    // Default constructor
+    AssignmentStore() = default;
+
+    // Build the store and its indices from loaded assignments, assigning ids where missing
+    explicit AssignmentStore(std::vector<AssignmentPtr> assignments);
+
+    // Add an assignment at the end of the list and return its id.
+    // Assignments without an id, whose id is already taken or is the reserved maximum get a fresh one.
+    AssignmentId add(AssignmentPtr assignment);
+
+    // Remove an assignment by id; returns false if there is none
+    bool remove(AssignmentId id);
+
+    // Replace an assignment by id, keeping its id and list position (and posting position if the
+    // subject is unchanged); returns false if there is none
+    bool update(AssignmentId id, AssignmentPtr replacement);
+
+    // Assignment with the given id, or nullptr
+    AssignmentPtr find(AssignmentId id) const;
+
+    // Remove the assignment at the given list position (throws std::out_of_range)
+    void removeAt(std::size_t index);
+
+    // Assignments in list order
+    const std::vector<AssignmentPtr>& all() const;
+    const AssignmentPtr& at(std::size_t index) const;
+    std::size_t size() const;
+    bool empty() const;
+
+    // Approximate heap footprint of the assignments and indices, in bytes. Counts each assignment
+    // as its own heap allocation: assignments still in a load arena pin more than this reports.
+    std::size_t memoryUsage() const;
+
+    // Secondary indices
+    const DeadlineIndex& byDeadline() const;    // Shortest deadline first
+    const DurationIndex& byDuration() const;    // Biggest duration first
+    const std::vector<AssignmentPtr>& bySubject(const std::string& subject) const;
+    const SubjectPosting* subjectPosting(SubjectId subject) const; // nullptr if the subject has no assignments
+    const SubjectIndex& bySubjectId() const;
+
+private:
+    // Where an assignment sits in the list and in its subject's posting list
+    struct Slot {
+        std::size_t list = 0;
+        std::size_t posting = 0;
+    };
+
+    // Reads compact pending tombstones, so the list and postings are mutable
+    mutable std::vector<AssignmentPtr> assignments;     // nullptr marks a removed assignment
+    mutable std::unordered_map<AssignmentId, Slot> positions;
+    mutable SubjectIndex subjectIndex;
+    mutable std::size_t removed = 0;                    // Tombstones in assignments
+    mutable std::size_t postingsRemoved = 0;            // Tombstones across all posting lists
+    AssignmentId nextId = 1;
+    DeadlineIndex deadlineIndex;
+    DurationIndex durationIndex;
+
+    AssignmentId freshId() const;
+    void compact() const;
+    void compactPosting(SubjectPosting& posting) const;
+    void indexOrdered(const AssignmentPtr& assignment);   // Deadline and duration indices
+    void unindexOrdered(const AssignmentPtr& assignment);
+    void indexAssignment(const AssignmentPtr& assignment, Slot& slot);
+    void unindexAssignment(const AssignmentPtr& assignment, const Slot& slot);
+};
+
+#endif // ASSIGNMENTSTORE_HPP
@@ -0,0 +1,61 @@
+#ifndef ASYNCSAVER_HPP
+#define ASYNCSAVER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "assignment.hpp"
+
+// Writes assignment files on a background thread so edits never wait on disk.
+// Each save() hands over a snapshot of the assignment pointers; requests for a file
+// that is still queued replace the pending snapshot, so a burst of edits costs one write.
+// Snapshots share the Assignment objects with the caller, which must replace rather than
+// modify assignments it has handed over (AssignmentStore::update does this).
+class AsyncSaver {
+public:
+    using AssignmentPtr = std::shared_ptr<Assignment>;
+
+    // Save counters
+    struct Stats {
+        std::size_t requested = 0;
+        std::size_t written = 0;
+        std::size_t coalesced = 0;
+    };
+
+    AsyncSaver();
+
+    // Writes everything still queued before returning
+    ~AsyncSaver();
+
+    AsyncSaver(const AsyncSaver&) = delete;
+    AsyncSaver& operator=(const AsyncSaver&) = delete;
+
+    // Queue `snapshot` to be written to `filename`
+    void save(const std::string& filename, std::vector<AssignmentPtr> snapshot);
+
+    // Block until every queued save has been written
+    void flush();
+
+    Stats stats() const;
+
+private:
+    mutable std::mutex mutex;
+    std::condition_variable wake;    // Signals the writer: work queued or stopping
+    std::condition_variable drained; // Signals flush(): queue empty and writer idle
+    std::unordered_map<std::string, std::vector<AssignmentPtr>> pending;
+    std::deque<std::string> order; // Files in the order they were first queued
+    bool writing = false;
+    bool stopping = false;
+    Stats counters;
+    std::thread writer;
+
+    void run();
+};
+
+#endif // ASYNCSAVER_HPP
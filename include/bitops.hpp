@@ -0,0 +1,44 @@
+#ifndef BITOPS_HPP
+#define BITOPS_HPP
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Portable bit scans for 64-bit words (std::countr_zero and std::popcount arrive only in C++20)
+namespace BitOps {
+    // Index of the lowest set bit; `word` must not be zero
+    inline int countTrailingZeros(std::uint64_t word) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int count = 0;
+        while (!(word & 1)) {
+            word >>= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    inline int popCount(std::uint64_t word) {
+#if defined(_MSC_VER)
+        return static_cast<int>(__popcnt64(word));
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#else
+        int count = 0;
+        for (; word; word &= word - 1)
+            ++count;
+        return count;
+#endif
+    }
+}
+
+#endif // BITOPS_HPP
@@ -0,0 +1,73 @@
+#ifndef BUSYCALENDAR_HPP
+#define BUSYCALENDAR_HPP
+
+#include <climits>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class TimeGrid;
+struct CivilDate;
+
+// A busy event from an existing calendar. Times are local minutes since 1970-01-01.
+struct BusyEvent {
+    enum class Frequency { Once, Daily, Weekly };
+
+    long long start = 0;
+    long long duration = 0; // Minutes
+    Frequency frequency = Frequency::Once;
+    int interval = 1;
+    long long count = -1;        // Number of occurrences, -1 without a limit
+    long long until = LLONG_MAX; // Latest occurrence start
+    unsigned weekdays = 0;       // BYDAY bits, bit 0 = Sunday; zero for none
+};
+
+// Busy times read from an iCalendar (.ics) file, used to keep study time out of them.
+//
+// The parser streams over the text once: lines are unfolded on the fly and only VEVENT
+// properties are looked at. DTSTART, DTEND and DURATION set an event's time. Dates without a
+// time block whole days, and UTC times are shifted into local time by the offset in force at
+// that instant. Times with a TZID are not converted: they are read as floating local time, which
+// is right only when the TZID is the local zone. A simple RRULE is expanded
+// when blocking: FREQ=DAILY or WEEKLY with INTERVAL, COUNT, UNTIL and BYDAY. Other recurrences
+// (MONTHLY, BYSETPOS, ...) are blocked conservatively: the event's time every day until the rule's
+// UNTIL, or whole days when the rule may move the time of day. EXDATEs are ignored, so excluded
+// occurrences stay busy. Transparent and cancelled events block nothing.
+class BusyCalendar {
+public:
+    BusyCalendar() = default;
+
+    // Convert UTC times to local time with a fixed `utcOffsetMinutes`
+    static BusyCalendar parse(std::string_view text, int utcOffsetMinutes);
+
+    // Convert UTC times with the system time zone, so times across a DST change each get their own offset
+    static BusyCalendar parse(std::string_view text);
+
+    // Parse a file in the system time zone. Throws FileException.
+    static BusyCalendar fromFile(const std::string& filename);
+
+    // Offset of local time from UTC right now, or at a UTC instant given in minutes since 1970-01-01
+    static int localUtcOffsetMinutes();
+    static int localUtcOffsetMinutes(long long utcMinutes);
+
+    const std::vector<BusyEvent>& events() const { return busyEvents; }
+
+    // Events that were malformed and skipped, and recurrence rules that were not understood
+    // (blocked conservatively; worth telling the user, as they may hide free study time)
+    std::size_t skipped() const { return skippedEvents; }
+    std::size_t unsupportedRules() const { return ignoredRules; }
+
+    // Mark every occurrence overlapping the grid's study windows busy. Schedule day d falls
+    // on base + d days, as in StudyCalendar::capacity.
+    void block(TimeGrid& grid, const CivilDate& base) const;
+
+private:
+    static BusyCalendar parse(std::string_view text, bool systemZone, int utcOffsetMinutes);
+
+    std::vector<BusyEvent> busyEvents;
+    std::size_t skippedEvents = 0;
+    std::size_t ignoredRules = 0;
+};
+
+#endif // BUSYCALENDAR_HPP
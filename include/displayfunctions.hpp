@@ -4,14 +4,25 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <cstddef>
+#include <limits>
 #include "assignment.hpp"
+#include "assignmentstore.hpp"
+#include "assignmentrenderer.hpp"
 
 class DisplayFunctions {
 public:
     using AssignmentPtr = std::shared_ptr<Assignment>;
 
+    // Row limit meaning "show every assignment"
+    static constexpr std::size_t ShowAll = std::numeric_limits<std::size_t>::max();
+
+    // Output layout of the display views (detailed by default)
+    static void setLayout(AssignmentRenderer::Layout layout);
+    static AssignmentRenderer::Layout getLayout();
+
     // Display menu options for assignments
-    static void displayMenu(const std::vector<AssignmentPtr>& assignments);
+    static void displayMenu(const AssignmentStore& store);
 
     // Display all assignments
     static void displayAllAssignments(const std::vector<AssignmentPtr>& assignments);
@@ -19,11 +30,24 @@ public:
     // Display assignments filtered by subject
     static void displayAssignmentsBySubject(const std::vector<AssignmentPtr>& assignments, const std::string& subject);
 
-    // Display assignments sorted by shortest deadline
-    static void displayAssignmentsByShortestDeadline(const std::vector<AssignmentPtr>& assignments);
+    // Display assignments sorted by shortest deadline (at most `limit` of them)
+    static void displayAssignmentsByShortestDeadline(const std::vector<AssignmentPtr>& assignments, std::size_t limit = ShowAll);
+
+    // Display assignments sorted by biggest duration (at most `limit` of them)
+    static void displayAssignmentsByBiggestDuration(const std::vector<AssignmentPtr>& assignments, std::size_t limit = ShowAll);
+
+    // Display assignments due within the given number of days, soonest first
+    static void displayAssignmentsDueWithin(const std::vector<AssignmentPtr>& assignments, int days);
+
+    // Store-backed views iterate the store's maintained indices instead of sorting
+    static void displayAllAssignments(const AssignmentStore& store);
+    static void displayAssignmentsBySubject(const AssignmentStore& store, const std::string& subject);
+    static void displayAssignmentsByShortestDeadline(const AssignmentStore& store, std::size_t limit = ShowAll);
+    static void displayAssignmentsByBiggestDuration(const AssignmentStore& store, std::size_t limit = ShowAll);
+    static void displayAssignmentsDueWithin(const AssignmentStore& store, int days);
 
-    // Display assignments sorted by biggest duration
-    static void displayAssignmentsByBiggestDuration(const std::vector<AssignmentPtr>& assignments);
+    // Display assignment count and total hours per subject
+    static void displaySubjectSummary(const AssignmentStore& store);
 };
 
 #endif // DISPLAYFUNCTIONS_HPP
@@ -0,0 +1,41 @@
+#ifndef ICSREADER_HPP
+#define ICSREADER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Building blocks for streaming over iCalendar (RFC 5545) text
+namespace IcsReader {
+    // Unfolded content lines of an iCalendar text. Lines are viewed in place; only folded
+    // lines are copied together, into storage reused for the next folded line.
+    class LineReader {
+    public:
+        explicit LineReader(std::string_view text) : text(text) {}
+
+        // The next line, valid until the following call; false at the end of the text
+        bool next(std::string_view& line);
+
+    private:
+        std::string_view text;
+        std::size_t position = 0;
+        std::string unfolded;
+
+        bool continues() const;
+        std::string_view physicalLine();
+    };
+
+    struct Property {
+        std::string_view name;
+        std::string_view params; // Including the leading ';', if any
+        std::string_view value;
+    };
+
+    // NAME;PARAM=...:VALUE, where the value starts at the first ':' outside quotes
+    bool splitProperty(std::string_view line, Property& property);
+
+    // ASCII case-insensitive comparison against an upper-case literal
+    bool equals(std::string_view text, std::string_view upper);
+}
+
+#endif // ICSREADER_HPP
@@ -0,0 +1,89 @@
+#ifndef ICSSCHEDULE_HPP
+#define ICSSCHEDULE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "assignment.hpp"
+#include "outputbuffer.hpp"
+#include "studycalendar.hpp"
+
+// A study session as written to an ICS schedule
+struct IcsEvent {
+    std::string uid;
+    std::string summary;
+    std::string start; // Floating local date-time, YYYYMMDDTHHMMSS
+    std::string end;
+    std::string rrule;                // Recurrence of a series, empty for a single session
+    std::vector<std::string> exdates; // Starts of skipped occurrences within a series
+    int sequence = 0;                 // Revision, raised whenever a published event changes
+};
+
+// A study session placed by the scheduler, in minutes from midnight of its schedule day's date
+struct IcsSession {
+    std::size_t assignment; // Index into the scheduled assignment list
+    int day;
+    int startMinute;
+    int endMinute;
+};
+
+// Writing, reading and diffing the ICS schedules produced by the planner
+namespace IcsSchedule {
+    // Local date-time `minute` minutes after midnight of `date` (may run into later days),
+    // computed without the C time functions; throws std::out_of_range outside years 0 to 9999
+    std::string formatDateTime(const CivilDate& date, long long minute);
+
+    // UTC DTSTAMP value for midnight of `date`; stamping with a date rather than the clock keeps
+    // rewritten schedules reproducible
+    std::string formatStamp(const CivilDate& date);
+
+    // Stable UID of an assignment's n-th study session, counting from 1. Uses the assignment id,
+    // or a hash of subject and name for assignments that were never stored.
+    std::string sessionUid(const Assignment& assignment, int session);
+
+    // UID of a session known only by its start and summary, as appended by Planner::addToICSFile
+    std::string sessionUid(std::string_view start, std::string_view summary);
+
+    // Longest run of days without a session that a daily series bridges with EXDATEs
+    constexpr int MaxSeriesGapDays = 2;
+
+    // Events for the sessions of a schedule whose day d falls on baseDate + d, in order of first
+    // occurrence. With `compress`, adjacent sessions of an assignment on a day merge into one
+    // block, and blocks repeating at the same time on following days fold into a single event
+    // with RRULE:FREQ=DAILY;COUNT=n and EXDATEs for the days in between without that block.
+    // Otherwise every session is its own event. UIDs number each assignment's events.
+    std::vector<IcsEvent> buildEvents(const std::vector<IcsSession>& sessions,
+                                      const std::vector<std::shared_ptr<Assignment>>& assignments,
+                                      const CivilDate& baseDate, bool compress);
+
+    // A VEVENT with `stamp` as its DTSTAMP, which RFC 5545 requires on every event
+    void writeEvent(OutputBuffer& out, const IcsEvent& event, std::string_view stamp, bool cancelled = false);
+    void writeEvent(std::ostream& out, const IcsEvent& event, std::string_view stamp, bool cancelled = false);
+
+    // A whole VCALENDAR with the planner's header around `events`, stamped with midnight UTC of `stampDate`
+    void writeCalendar(OutputBuffer& out, const std::vector<IcsEvent>& events, const CivilDate& stampDate);
+
+    // Events with a UID in a schedule written before, in file order
+    std::vector<IcsEvent> readEvents(std::string_view text);
+
+    struct Delta {
+        std::vector<IcsEvent> published; // Added or changed events
+        std::vector<IcsEvent> cancelled; // Events no longer in the schedule
+        std::size_t unchanged = 0;
+    };
+
+    // Compare a new schedule with the previous one; events differ when their summary, times or
+    // recurrence differ. Sequence numbers carry over into
+    // `current` and are raised for events that changed; cancellations get the next one too.
+    Delta diff(const std::vector<IcsEvent>& previous, std::vector<IcsEvent>& current);
+
+    // A METHOD:PUBLISH calendar of the added and changed events followed by a METHOD:CANCEL
+    // calendar of the removed ones; empty parts are left out. Events are stamped with
+    // midnight UTC of `stampDate` so the delta stays reproducible.
+    void writeDelta(std::ostream& out, const Delta& delta, const CivilDate& stampDate);
+}
+
+#endif // ICSSCHEDULE_HPP
@@ -0,0 +1,103 @@
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+enum class LogLevel { Trace = 0, Debug = 1, Info = 2, Warn = 3, Error = 4, Off = 5 };
+
+// Records below this level are compiled out entirely (set through the PLANNER_LOG_MIN_LEVEL cache variable)
+#ifndef PLANNER_LOG_MIN_LEVEL
+#define PLANNER_LOG_MIN_LEVEL 1
+#endif
+
+// Leveled logging through a background writer. Records are queued in a bounded ring and written
+// in batches: Info and below to the output stream, Warn and Error to the error stream with a
+// "Warning: " or "Error: " prefix. When the ring is full the caller waits for room, unless the
+// overflow policy is Drop, which discards (and counts) Trace to Info records instead.
+namespace Log {
+    constexpr std::size_t RingCapacity = 4096;
+
+    enum class Overflow {
+        Block, // Every record is written; output such as the schedule listing is never lossy
+        Drop   // Records below Warn are dropped rather than stall the caller, e.g. in the daemon
+    };
+
+    // Block by default
+    void setOverflow(Overflow policy);
+
+    // Runtime threshold, Info by default
+    void setLevel(LogLevel level);
+    LogLevel level();
+    bool enabled(LogLevel level);
+
+    // Parse a level name (trace, debug, info, warn, error, off); throws std::invalid_argument
+    LogLevel parseLevel(std::string_view name);
+
+    // Queue one record; the writer adds the line break
+    void write(LogLevel level, std::string text);
+
+    // Block until every queued record has been written
+    void flush();
+
+    // Redirect output, e.g. in tests; queued records are written to the old streams first
+    void setStreams(std::ostream& out, std::ostream& errors);
+
+    // Records dropped because the ring was full under Overflow::Drop
+    std::size_t dropped();
+
+    // Builds one record from << pieces and queues it when destroyed
+    class Line {
+    public:
+        explicit Line(LogLevel level) : level(level) {}
+        ~Line() { write(level, std::move(text)); }
+
+        Line(const Line&) = delete;
+        Line& operator=(const Line&) = delete;
+
+        Line& operator<<(std::string_view piece) { text.append(piece.data(), piece.size()); return *this; }
+        Line& operator<<(const char* piece) { return *this << std::string_view(piece); }
+        Line& operator<<(const std::string& piece) { return *this << std::string_view(piece); }
+        Line& operator<<(char c) { text.push_back(c); return *this; }
+        Line& operator<<(bool value) { return *this << (value ? "true" : "false"); }
+        Line& operator<<(double value);
+
+        template <typename Integer, typename = std::enable_if_t<std::is_integral_v<Integer>>>
+        Line& operator<<(Integer value) {
+            if constexpr (std::is_unsigned_v<Integer>)
+                appendUnsigned(value);
+            else
+                appendSigned(value);
+            return *this;
+        }
+
+    private:
+        LogLevel level;
+        std::string text;
+
+        void appendSigned(long long value);
+        void appendUnsigned(unsigned long long value);
+    };
+}
+
+// PLANNER_LOG(LogLevel::Debug, "Day " << day) formats and queues a record only when the level is
+// compiled in and enabled, so disabled records cost one comparison and compiled-out ones nothing
+#define PLANNER_LOG(logLevel, pieces)                                                \
+    do {                                                                             \
+        if constexpr (static_cast<int>(logLevel) >= PLANNER_LOG_MIN_LEVEL) {         \
+            if (Log::enabled(logLevel))                                              \
+                Log::Line(logLevel) << pieces;                                       \
+        }                                                                            \
+    } while (0)
+
+#define LOG_TRACE(pieces) PLANNER_LOG(LogLevel::Trace, pieces)
+#define LOG_DEBUG(pieces) PLANNER_LOG(LogLevel::Debug, pieces)
+#define LOG_INFO(pieces) PLANNER_LOG(LogLevel::Info, pieces)
+#define LOG_WARN(pieces) PLANNER_LOG(LogLevel::Warn, pieces)
+#define LOG_ERROR(pieces) PLANNER_LOG(LogLevel::Error, pieces)
+
+#endif // LOGGER_HPP
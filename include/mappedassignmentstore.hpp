@@ -0,0 +1,79 @@
+#ifndef MAPPEDASSIGNMENTSTORE_HPP
+#define MAPPEDASSIGNMENTSTORE_HPP
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "assignment.hpp"
+
+// Read-only view of a whole file. Uses mmap on POSIX systems and reads the file
+// into memory elsewhere. The text stays at the same address when the object is moved.
+class MappedFile {
+public:
+    // Throws FileException when the file cannot be opened or mapped
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view text() const;
+
+private:
+    const char* data = nullptr;
+    std::size_t length = 0;
+    bool mapped = false;      // data came from mmap and must be unmapped
+    std::vector<char> buffer; // Backing storage when the file was read instead of mapped
+
+    void release();
+};
+
+// Assignment fields as stored in the file, with strings viewed in place
+struct AssignmentView {
+    AssignmentId id = 0;
+    std::string_view subject;
+    std::string_view name;
+    int deadline = 0;
+    int duration = 0;
+    float weight = 0.0f;
+    int size = 0;
+    bool groupWork = false;
+    int groupSize = 0;
+
+    // Duration adjusted for group size, as Assignment::getRealDuration
+    int realDuration() const { return duration / groupSize; }
+};
+
+// Read-only assignments loaded straight from a mapped assignment file for batch jobs.
+// Subjects and names point into the mapping; only strings with escapes are decoded into
+// storage owned by the store. The views stay valid for the lifetime of the store.
+// Library API for batch tools built on the engine (see computeSchedule for AssignmentView);
+// the planner executable itself edits user files and loads them with Planner::loadFromFile.
+class MappedAssignmentStore {
+public:
+    // Throws FileException when the file cannot be read, is not a valid assignment file or
+    // holds out-of-range fields (see Assignment::validFields)
+    explicit MappedAssignmentStore(const std::string& filename);
+
+    const std::vector<AssignmentView>& all() const;
+    const AssignmentView& at(std::size_t index) const;
+    std::size_t size() const;
+    bool empty() const;
+
+    // Number of strings that needed their own storage (escaped, or parsed by the general parser)
+    std::size_t decodedStrings() const;
+
+private:
+    MappedFile file;
+    std::deque<std::string> decoded; // Stable addresses for decoded strings
+    std::vector<AssignmentView> assignments;
+
+    std::string_view keep(std::string_view text);
+    void loadWithJson(const std::string& filename);
+};
+
+#endif // MAPPEDASSIGNMENTSTORE_HPP
@@ -0,0 +1,36 @@
+#ifndef NDJSONIMPORT_HPP
+#define NDJSONIMPORT_HPP
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "assignment.hpp"
+
+// Bulk import of assignments for many users from NDJSON: one assignment object per line,
+// with the usual assignment fields plus "user". The text is split into chunks at line
+// boundaries and the chunks are parsed on parallel threads.
+namespace NdjsonImport {
+    using AssignmentPtr = std::shared_ptr<Assignment>;
+
+    // Parsed import, in file order per user
+    struct Result {
+        std::map<std::string, std::vector<AssignmentPtr>> users;
+        std::size_t assignments = 0;
+        std::vector<std::size_t> badLines; // 1-based numbers of lines that could not be parsed
+        std::vector<std::string> rejectedUsers; // Users not written because the name is not a safe file name
+        std::vector<std::string> unreadableUsers; // Users not written because their existing file could not be loaded
+    };
+
+    // Parse NDJSON text using up to `threads` threads (0 picks the hardware concurrency)
+    Result parse(std::string_view text, unsigned threads = 0);
+
+    // Import `filename` and merge each user's assignments into <dataDirectory>/<user>.json,
+    // keeping what the file already holds. Bad lines (including out-of-range fields) and users whose
+    // existing file cannot be loaded are logged as errors and skipped.
+    Result importFile(const std::string& filename, const std::string& dataDirectory = "Data", unsigned threads = 0);
+}
+
+#endif // NDJSONIMPORT_HPP
@@ -0,0 +1,52 @@
+#ifndef OUTPUTBUFFER_HPP
+#define OUTPUTBUFFER_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Append-only text buffer that reaches its stream in large writes.
+// Numbers are formatted with std::to_chars straight into the buffer.
+class OutputBuffer {
+public:
+    static constexpr std::size_t DefaultFlushThreshold = 64 * 1024;
+
+    explicit OutputBuffer(std::ostream& out, std::size_t flushThreshold = DefaultFlushThreshold);
+
+    // Flushes whatever is still buffered
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    OutputBuffer& append(std::string_view text);
+    OutputBuffer& append(char c);
+    OutputBuffer& appendInt(long long value);
+    OutputBuffer& appendUnsigned(unsigned long long value);
+
+    // Same text as an ostream's default float formatting (six significant digits)
+    OutputBuffer& appendFloat(float value);
+
+    // Shortest text that reads back as the same float
+    OutputBuffer& appendShortestFloat(float value);
+
+    // Quoted JSON string with the required escapes
+    OutputBuffer& appendJsonString(std::string_view text);
+
+    // `text` cut or space-padded to exactly `width` bytes
+    OutputBuffer& appendPadded(std::string_view text, std::size_t width);
+
+    // Write the buffered text to the stream
+    void flush();
+
+    // Flush once the buffer has grown past the threshold; call at record boundaries
+    void flushIfFull();
+
+private:
+    std::ostream& out;
+    std::size_t flushThreshold;
+    std::string buffer;
+};
+
+#endif // OUTPUTBUFFER_HPP
@@ -2,6 +2,8 @@
 #define PLANNER_HPP
 
 #include "assignment.hpp"
+#include "schedulesink.hpp"
+#include "studycalendar.hpp"
 #include <vector>
 #include <string>
 #include <memory>
@@ -11,22 +13,70 @@ namespace Planner {
     // Define a shared pointer for assignments
     using AssignmentPtr = std::shared_ptr<Assignment>;
 
+    // Layout of saved assignment files
+    enum class JsonStyle {
+        Pretty,  // 4-space indented, one field per line
+        Compact  // No whitespace
+    };
+
     // Function declarations
 
     // Load assignments from a file
     std::vector<AssignmentPtr> loadFromFile(const std::string& filename);
 
-    // Save assignments to a file
-    void saveToFile(const std::string& filename, const std::vector<AssignmentPtr>& assignments);
+    // Load every assignment of an existing file; throws FileException when it cannot be read or parsed,
+    // so callers never mistake a damaged file for an empty one
+    std::vector<AssignmentPtr> loadExistingFile(const std::string& filename);
+
+    // Whether a user name is safe to use as a file name under Data/
+    bool isValidUserName(const std::string& name);
+
+    // Save assignments to a file; returns false (after logging why) when the file could not be written
+    bool saveToFile(const std::string& filename, const std::vector<AssignmentPtr>& assignments,
+                    JsonStyle style = JsonStyle::Pretty);
 
     // Calculate the priority of an assignment based on the given study hours
     int calculatePriority(const Assignment& assignment, int studyHoursPerDay);
 
-    // Priority-based scheduler for assignments
+    // Calculate the priority from raw scheduling state (remaining deadline and real duration)
+    int calculatePriority(int deadline, int realDuration, float weight, int size, int studyHoursPerDay);
+
+    // Priority-based scheduler for assignments, studying on weekdays and weekends of the real calendar
     void scheduler(const std::vector<AssignmentPtr>& assignments, int weekdayStudyHours, int weekendStudyHours, const std::string& userName);
 
+    // Priority-based scheduler taking each day's study hours from the calendar, starting tomorrow
+    void scheduler(const std::vector<AssignmentPtr>& assignments, const StudyCalendar& calendar, const std::string& userName);
+
+    // How Planner::scheduler writes the ICS schedule
+    struct IcsOptions {
+        // Also write the events added, changed or cancelled since the previous schedule to
+        // Data/<user>_schedule_delta.ics
+        bool writeDelta = false;
+        // Merge adjacent hours and fold blocks repeating on following days into RRULE events
+        bool compressRecurring = true;
+    };
+
+    // Same, with day d of the schedule falling on baseDate + d. Output depends only on the inputs
+    // and the previous schedule, whose sequence numbers carry over.
+    void scheduler(const std::vector<AssignmentPtr>& assignments, const StudyCalendar& calendar, const std::string& userName,
+                   const CivilDate& baseDate, const IcsOptions& options = IcsOptions());
+
+    // Schedule against the calendar with day d falling on baseDate + d and hand every placed
+    // session and missed deadline to `sink`, without any console output
+    void emitSchedule(const std::vector<AssignmentPtr>& assignments, const StudyCalendar& calendar,
+                      const CivilDate& baseDate, ScheduleSink& sink);
+
+    // Write the schedule as csv, ndjson or binary to Data/<user>_schedule.<extension of format> and
+    // return that path; throws std::invalid_argument for the ICS and null formats and FileException
+    // when the file cannot be created
+    std::string exportSchedule(const std::vector<AssignmentPtr>& assignments, const StudyCalendar& calendar,
+                               const std::string& userName, const CivilDate& baseDate, ScheduleExport::Format format);
+
     // Add an assignment schedule to an ICS file
     void addToICSFile(const std::string& icsFilePath, const std::string& assignmentName, int dayOffset, int hour);
+
+    // Add a study session starting `startMinute` minutes after midnight of `date` to an ICS file
+    void addToICSFile(const std::string& icsFilePath, const std::string& assignmentName, const CivilDate& date, int startMinute, int minutes);
 }
 
 #endif // PLANNER_HPP
@@ -0,0 +1,44 @@
+#ifndef PLANNERDAEMON_HPP
+#define PLANNERDAEMON_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include "userstorecache.hpp"
+
+// Long-running server that keeps users' assignment stores in memory.
+// Clients send one JSON-RPC 2.0 request per line over a Unix domain socket and
+// receive one response line. Supported methods: add, update, delete (by assignment id),
+// list, schedule, export_ics, export_schedule, stats and shutdown; user methods name their user
+// in params.user. schedule and the exports take an optional params.base_date (YYYY-MM-DD, default today);
+// export_ics with params.delta also writes the changes since the previous export, and
+// params.compress = false writes one event per session instead of RRULE series.
+// export_schedule writes params.format (csv, ndjson or binary) and returns its path.
+// Stores are kept in an LRU cache bounded by `cacheBudget` bytes; changed stores
+// are saved to Data/<user>.json after a few changes or seconds (UserStoreCache write-back),
+// when evicted and when the daemon stops.
+class PlannerDaemon {
+public:
+    explicit PlannerDaemon(std::size_t cacheBudget = UserStoreCache::DefaultByteBudget);
+
+    PlannerDaemon(const PlannerDaemon&) = delete;
+    PlannerDaemon& operator=(const PlannerDaemon&) = delete;
+
+    // Handle one request line and return the response line (without the newline)
+    std::string handleRequest(const std::string& line);
+
+    // Accept connections on the socket until stop() or a shutdown request (throws FileException)
+    void serve(const std::string& socketPath);
+
+    // Ask serve() to return; safe to call from another thread
+    void stop();
+
+    // Write back every changed store
+    void flush();
+
+private:
+    UserStoreCache stores;
+    std::atomic<bool> running{false};
+};
+
+#endif // PLANNERDAEMON_HPP
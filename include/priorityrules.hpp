@@ -0,0 +1,75 @@
+#ifndef PRIORITYRULES_HPP
+#define PRIORITYRULES_HPP
+
+#include <algorithm>
+#include <climits>
+#include <string>
+#include <vector>
+
+// Priority scoring policy compiled into lookup tables.
+//
+// The policy is JSON with one rule list per factor; within a list the first matching rule
+// gives the factor's points, and no match gives 0. The defaults are:
+//     {
+//         "deadline": [{"below": 2, "points": 10}, {"below": 4, "points": 8},
+//                      {"below": 6, "points": 6}, {"below": 8, "points": 4}],
+//         "slack":    [{"below": 2, "points": 20}, {"below": 4, "points": 15},
+//                      {"below": 6, "points": 10}],
+//         "weight":   [{"above": 20, "points": 6}, {"above": 15, "points": 4},
+//                      {"above": 10, "points": 2}],
+//         "size":     [{"equals": 1, "points": 3}, {"equals": 2, "points": 2},
+//                      {"equals": 3, "points": 1}]
+//     }
+// Slack is deadline * study hours per day - real duration. Integer factors accept "below",
+// "above" and "equals" rules; weight accepts "above" rules. Missing factors score 0.
+class PriorityRules {
+public:
+    // The built-in policy, identical to the original hardcoded branches
+    PriorityRules();
+
+    // Compile a policy from JSON text; throws std::invalid_argument when it is malformed
+    static PriorityRules fromJson(const std::string& text);
+
+    // Load a policy file; throws FileException or std::invalid_argument
+    static PriorityRules fromFile(const std::string& filename);
+
+    // Rules used by Planner::calculatePriority. Replace them only while no scheduler is running.
+    static const PriorityRules& active();
+    static void setActive(const PriorityRules& rules);
+
+    int score(int deadline, int realDuration, float weight, int size, int studyHoursPerDay) const {
+        int slack = deadline * studyHoursPerDay - realDuration;
+        int bucket = 0;
+        for (float threshold : weightThresholds)
+            bucket += weight > threshold;
+        return deadlineTable.lookup(deadline) + slackTable.lookup(slack) + weightPoints[bucket] + sizeTable.lookup(size);
+    }
+
+    // Further days, after the one scored, over which the score of an assignment that is not
+    // worked on cannot change. Its deadline drops by one a day while study hours stay within
+    // [minHours, maxHours]; minHours must not be negative.
+    int stableDays(int deadline, int realDuration, int studyHoursPerDay, int minHours, int maxHours) const;
+
+    // Points of an integer factor for every value in [low, high]; values outside clamp to the ends
+    struct IntTable {
+        int low = 0;
+        int high = 0;
+        std::vector<int> points = {0};
+        std::vector<long long> runStart = {LLONG_MIN}; // First value with the same points, per entry
+        std::vector<long long> runEnd = {LLONG_MAX};   // Last value with the same points, per entry
+
+        int lookup(int value) const { return points[std::clamp(value, low, high) - low]; }
+    };
+
+private:
+    struct Empty {};
+    explicit PriorityRules(Empty); // Every factor scores 0
+
+    IntTable deadlineTable;
+    IntTable slackTable;
+    IntTable sizeTable;
+    std::vector<float> weightThresholds; // Ascending; the bucket is how many a weight exceeds
+    std::vector<int> weightPoints = {0}; // Points per bucket
+};
+
+#endif // PRIORITYRULES_HPP
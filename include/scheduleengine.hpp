@@ -0,0 +1,64 @@
+#ifndef SCHEDULEENGINE_HPP
+#define SCHEDULEENGINE_HPP
+
+#include "assignment.hpp"
+#include "mappedassignmentstore.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Compute-only core of the priority-based scheduler
+namespace Planner {
+    using AssignmentPtr = std::shared_ptr<Assignment>;
+
+    // One hour of study placed by the scheduler
+    struct ScheduledSlot {
+        int day;                // Day offset from today (starting at 1)
+        int hour;               // Hour within the day's study window (starting at 0)
+        std::size_t assignment; // Index into the scheduled assignment list
+    };
+
+    // An assignment dropped because its deadline passed before it was finished
+    struct MissedDeadline {
+        int day;
+        std::size_t assignment;
+    };
+
+    // Everything the scheduler decided, in the order it decided it
+    struct ScheduleResult {
+        std::vector<ScheduledSlot> slots;
+        std::vector<MissedDeadline> missed;
+        int days = 0; // Number of days simulated
+    };
+
+    // Study hours of each schedule day, day d stored at index d - 1; later days have no hours
+    using DayCapacity = std::vector<int>;
+
+    // Study hours available on the given day under the legacy weekday/weekend rule
+    int studyHoursForDay(int day, int weekdayStudyHours, int weekendStudyHours);
+
+    // Number of days a schedule of the assignments can span: each is finished or dropped by its deadline
+    int scheduleHorizon(const std::vector<AssignmentPtr>& assignments);
+    int scheduleHorizon(const std::vector<AssignmentView>& assignments);
+
+    // Schedule the assignments hour by hour without modifying them. Equal priorities are taken in
+    // the same order as the original scheduler's std::priority_queue.
+    ScheduleResult computeSchedule(const std::vector<AssignmentPtr>& assignments, int weekdayStudyHours, int weekendStudyHours);
+
+    // Same schedule for read-only assignments viewed in a mapped file
+    ScheduleResult computeSchedule(const std::vector<AssignmentView>& assignments, int weekdayStudyHours, int weekendStudyHours);
+
+    // Schedule with per-day study hours, e.g. from a StudyCalendar
+    ScheduleResult computeSchedule(const std::vector<AssignmentPtr>& assignments, const DayCapacity& capacity);
+    ScheduleResult computeSchedule(const std::vector<AssignmentView>& assignments, const DayCapacity& capacity);
+
+    // Original hardcoded priority branches, kept as the oracle for the default PriorityRules
+    int referencePriority(int deadline, int realDuration, float weight, int size, int studyHoursPerDay);
+
+    // Original shared_ptr/priority_queue scheduler, kept as the oracle for differential testing.
+    // Consumes the assignments' remaining duration and deadline like the original scheduler did.
+    ScheduleResult referenceSchedule(const std::vector<AssignmentPtr>& assignments, int weekdayStudyHours, int weekendStudyHours);
+    ScheduleResult referenceSchedule(const std::vector<AssignmentPtr>& assignments, const DayCapacity& capacity);
+}
+
+#endif // SCHEDULEENGINE_HPP
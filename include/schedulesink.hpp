@@ -0,0 +1,182 @@
+#ifndef SCHEDULESINK_HPP
+#define SCHEDULESINK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <vector>
+#include "assignment.hpp"
+#include "icsschedule.hpp"
+#include "outputbuffer.hpp"
+#include "studycalendar.hpp"
+
+// A contiguous study session placed by the scheduler
+struct ScheduledSession {
+    std::size_t assignment; // Index into the scheduled assignment list
+    int day;                // Schedule day, falling on baseDate + day
+    int hour;               // Study hour of that day the session belongs to, from 0
+    int startMinute;        // Minutes after midnight of the day's date; may run past midnight
+    int endMinute;
+};
+
+// An assignment whose deadline passed before all of its hours were placed
+struct MissedDeadline {
+    std::size_t assignment;
+    int day;
+};
+
+// Receives a schedule as the scheduler produces it, in day order. begin() comes first and
+// finish() last; every schedule day gets a day() call before its sessions and missed deadlines.
+class ScheduleSink {
+public:
+    using Assignments = std::vector<std::shared_ptr<Assignment>>;
+
+    virtual ~ScheduleSink() = default;
+
+    // The assignment list outlives the sink's use of it, up to finish()
+    virtual void begin(const Assignments&, const CivilDate&) {}
+    virtual void day(int) {}
+    virtual void session(const ScheduledSession& session) = 0;
+    virtual void missed(const MissedDeadline&) {}
+    virtual void finish() {}
+};
+
+// Discards the schedule, keeping counts; isolates the cost of computing it
+class NullScheduleSink : public ScheduleSink {
+public:
+    void session(const ScheduledSession&) override { ++sessionCount; }
+    void missed(const MissedDeadline&) override { ++missedCount; }
+
+    std::size_t sessions() const { return sessionCount; }
+    std::size_t missedDeadlines() const { return missedCount; }
+
+private:
+    std::size_t sessionCount = 0;
+    std::size_t missedCount = 0;
+};
+
+// Forwards every call to several sinks in turn
+class TeeScheduleSink : public ScheduleSink {
+public:
+    explicit TeeScheduleSink(std::vector<ScheduleSink*> sinks);
+
+    void begin(const Assignments& assignments, const CivilDate& baseDate) override;
+    void day(int day) override;
+    void session(const ScheduledSession& session) override;
+    void missed(const MissedDeadline& missed) override;
+    void finish() override;
+
+private:
+    std::vector<ScheduleSink*> sinks;
+};
+
+// Base of the exporters that format records into a buffered stream
+class BufferedScheduleSink : public ScheduleSink {
+public:
+    explicit BufferedScheduleSink(std::ostream& out);
+
+    void begin(const Assignments& assignments, const CivilDate& baseDate) override;
+    void finish() override;
+
+protected:
+    OutputBuffer buffer;
+    const Assignments* assignments = nullptr;
+    CivilDate baseDate;
+};
+
+// The schedule as an ICS calendar. Sessions are collected until finish(), since series
+// compression needs all of them; `previous` events lend their sequence numbers (see IcsSchedule::diff).
+class IcsScheduleSink : public BufferedScheduleSink {
+public:
+    IcsScheduleSink(std::ostream& out, bool compress, std::vector<IcsEvent> previous = {});
+
+    void session(const ScheduledSession& session) override;
+    void finish() override;
+
+    // Changes against the previous events, available after finish()
+    const IcsSchedule::Delta& delta() const { return changes; }
+
+private:
+    bool compress;
+    std::vector<IcsEvent> previous;
+    std::vector<IcsSession> sessions;
+    IcsSchedule::Delta changes;
+};
+
+// kind,date,start,end,subject,name,id rows under a header; kind is "session" or "missed",
+// start and end are local YYYY-MM-DDTHH:MM times and stay empty for missed deadlines
+class CsvScheduleSink : public BufferedScheduleSink {
+public:
+    using BufferedScheduleSink::BufferedScheduleSink;
+
+    void begin(const Assignments& assignments, const CivilDate& baseDate) override;
+    void session(const ScheduledSession& session) override;
+    void missed(const MissedDeadline& missed) override;
+};
+
+// One JSON object per line with the same fields as the CSV export, plus the study hour of sessions
+class NdjsonScheduleSink : public BufferedScheduleSink {
+public:
+    using BufferedScheduleSink::BufferedScheduleSink;
+
+    void session(const ScheduledSession& session) override;
+    void missed(const MissedDeadline& missed) override;
+};
+
+// One record of the binary timeline
+struct TimelineRecord {
+    enum Kind : std::uint8_t { Session = 1, Missed = 2 };
+
+    Kind kind;
+    std::uint8_t hour;
+    std::uint16_t day;
+    std::uint16_t startMinute; // Zero for missed deadlines
+    std::uint16_t endMinute;
+    AssignmentId id;
+};
+
+// Compact little-endian timeline: the magic "SPTL", a version byte and the base date as an int32
+// day count from 1970-01-01, followed by 16-byte records of kind (u8), hour (u8), day (u16),
+// start and end minute (u16 each) and assignment id (u64)
+class BinaryScheduleSink : public BufferedScheduleSink {
+public:
+    static constexpr std::uint8_t Version = 1;
+    static constexpr std::size_t HeaderSize = 9;
+    static constexpr std::size_t RecordSize = 16;
+
+    using BufferedScheduleSink::BufferedScheduleSink;
+
+    void begin(const Assignments& assignments, const CivilDate& baseDate) override;
+    void session(const ScheduledSession& session) override;
+    void missed(const MissedDeadline& missed) override;
+
+    // session() and missed() throw std::out_of_range for values that do not fit their fields
+
+    // Decode a timeline; throws std::invalid_argument on a bad header or a truncated record
+    static std::vector<TimelineRecord> read(std::string_view data, CivilDate* baseDate = nullptr);
+
+private:
+    void record(const TimelineRecord& record);
+};
+
+namespace ScheduleExport {
+    enum class Format { Ics, Csv, Ndjson, Binary, Null };
+
+    // Parse a format name (ics, csv, ndjson, binary, null); throws std::invalid_argument
+    Format parseFormat(std::string_view name);
+
+    // Parse the name of a format written to its own file (csv, ndjson, binary); throws
+    // std::invalid_argument for anything else. The ICS schedule is written by Planner::scheduler,
+    // which carries sequence numbers over from the previous file.
+    Format parseFileFormat(std::string_view name);
+
+    // File extension of a format, without the dot
+    const char* extension(Format format);
+
+    // A sink writing `format` to `out`; ICS output is compressed into RRULE series
+    std::unique_ptr<ScheduleSink> makeSink(Format format, std::ostream& out);
+}
+
+#endif // SCHEDULESINK_HPP
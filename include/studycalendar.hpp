@@ -0,0 +1,102 @@
+#ifndef STUDYCALENDAR_HPP
+#define STUDYCALENDAR_HPP
+
+#include "busycalendar.hpp"
+#include "timegrid.hpp"
+#include <array>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Date in the proleptic Gregorian calendar. Conversions are pure arithmetic on day numbers
+// counted from 1970-01-01, so they do not depend on the time zone or the C library.
+struct CivilDate {
+    int year = 1970;
+    int month = 1; // 1..12
+    int day = 1;   // 1..31
+
+    static CivilDate fromDays(long long days);
+    long long toDays() const;
+
+    // 0 = Sunday ... 6 = Saturday
+    int weekday() const;
+
+    CivilDate plusDays(long long days) const;
+
+    // Local date of the system clock
+    static CivilDate today();
+
+    // "YYYY-MM-DD"; throws std::invalid_argument for anything else or an impossible date
+    static CivilDate parse(std::string_view text);
+    std::string toString() const;
+
+    bool operator==(const CivilDate& other) const;
+    bool operator!=(const CivilDate& other) const;
+};
+
+// Study hours available on real calendar dates: hours per weekday, holidays with no study
+// time and exception days with their own hours.
+//
+// Calendars can be loaded from JSON such as
+//     {
+//         "weekly": {"monday": 3, "tuesday": 3, "wednesday": 2, "thursday": 3,
+//                    "friday": 1, "saturday": 5, "sunday": 4},
+//         "holidays": ["2026-12-24", "2026-12-25"],
+//         "exceptions": {"2026-11-14": 8},
+//         "slot_minutes": 30,
+//         "window": {"start": "17:30", "end": "23:00"}
+//     }
+// Weekdays missing from "weekly" have no study hours. Exceptions take precedence over holidays.
+// Study time is placed in slots of "slot_minutes" (a divisor of 60, default 60) inside the daily
+// window, which defaults to 24 hours from 18:00; an end at or before the start runs past midnight.
+class StudyCalendar {
+public:
+    // Longest horizon a capacity vector is built for; later days have no study hours
+    static constexpr int MaxHorizonDays = 3660;
+
+    // Monday to Friday get `weekdayHours`, Saturday and Sunday `weekendHours`
+    explicit StudyCalendar(int weekdayHours = 0, int weekendHours = 0);
+
+    // Throws std::invalid_argument when the JSON is malformed
+    static StudyCalendar fromJson(const std::string& text);
+
+    // Throws FileException or std::invalid_argument
+    static StudyCalendar fromFile(const std::string& filename);
+
+    void setWeeklyHours(int weekday, int hours); // weekday: 0 = Sunday ... 6 = Saturday
+    void addHoliday(const CivilDate& date);
+    void setException(const CivilDate& date, int hours);
+
+    // Throws std::invalid_argument unless TimeGrid accepts the settings
+    void setSlotMinutes(int minutes);
+    void setStudyWindow(int startMinute, int minutes);
+
+    // Existing appointments that study time must avoid
+    void setBusyTimes(BusyCalendar busy);
+
+    int hoursOn(const CivilDate& date) const;
+
+    // Study hours of schedule days 1..days, where day d falls on base + d days,
+    // stored at index d - 1. `days` is capped at MaxHorizonDays.
+    std::vector<int> capacity(const CivilDate& base, int days) const;
+
+    // Study windows of schedule days 1..days, dated as in capacity(), with busy times blocked
+    TimeGrid timeGrid(const CivilDate& base, int days) const;
+
+    // Study hours of schedule days 1..days as in capacity(), each capped by the whole hours left free
+    // in `grid`, the timeGrid() of the same days: the hours a schedule can actually place
+    std::vector<int> freeCapacity(const CivilDate& base, int days, const TimeGrid& grid) const;
+    std::vector<int> freeCapacity(const CivilDate& base, int days) const;
+
+private:
+    std::array<int, 7> weekly{};
+    std::map<long long, int> holidays;   // Day numbers with no study time
+    std::map<long long, int> exceptions; // Day numbers with their own hours
+    int slotMinutes = 60;
+    int windowStart = 18 * 60;
+    int windowMinutes = 24 * 60;
+    BusyCalendar busyTimes;
+};
+
+#endif // STUDYCALENDAR_HPP
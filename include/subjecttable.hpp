@@ -0,0 +1,57 @@
+#ifndef SUBJECTTABLE_HPP
+#define SUBJECTTABLE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Small integer identifier of an interned subject name
+using SubjectId = std::uint32_t;
+
+// Process-wide dictionary of subject names.
+// Ids are dense, never reused, and names stay at a stable address for the life of the process.
+// Names live in fixed-size chunks that are never moved, and the count of finished names is
+// published atomically, so name() and size() read without taking a lock. Since ids are never
+// reclaimed the table holds at most MaxSubjects names; intern() throws std::length_error beyond.
+class SubjectTable {
+public:
+    static constexpr SubjectId InvalidId = std::numeric_limits<SubjectId>::max();
+    static constexpr std::size_t ChunkSize = 256;
+    static constexpr std::size_t MaxChunks = 4096;
+    static constexpr std::size_t MaxSubjects = ChunkSize * MaxChunks;
+
+    SubjectTable() = default;
+    ~SubjectTable();
+
+    SubjectTable(const SubjectTable&) = delete;
+    SubjectTable& operator=(const SubjectTable&) = delete;
+
+    // The table shared by every Assignment
+    static SubjectTable& global();
+
+    // Return the id of the subject, adding it on first use
+    SubjectId intern(std::string_view subject);
+
+    // Return the id of an already interned subject, or InvalidId
+    SubjectId find(std::string_view subject) const;
+
+    // Name of an interned subject (throws std::out_of_range); lock-free
+    const std::string& name(SubjectId id) const;
+
+    // Number of interned subjects; lock-free
+    std::size_t size() const;
+
+private:
+    mutable std::shared_mutex mutex;                   // Guards `ids` and adding names
+    std::array<std::atomic<std::string*>, MaxChunks> chunks{};
+    std::atomic<std::size_t> published{0};             // Names below this index are complete
+    std::unordered_map<std::string_view, SubjectId> ids; // Keys view into the chunks
+};
+
+#endif // SUBJECTTABLE_HPP
@@ -0,0 +1,61 @@
+#ifndef TIMEGRID_HPP
+#define TIMEGRID_HPP
+
+#include <cstdint>
+#include <vector>
+
+// A contiguous run of slots on one schedule day
+struct SlotRun {
+    int day;       // Schedule day, starting at 1
+    int firstSlot; // Slot index within the day's study window
+    int length;    // Number of slots
+};
+
+// Free study time of every day of a run at a fixed slot granularity. Each day's study window
+// is a bitset (bit set = free), so counting free time is a popcount per word and finding the
+// next free or busy slot is a single bit scan instead of a walk over the slots.
+class TimeGrid {
+public:
+    // `days` schedule days whose window starts `windowStart` minutes after midnight and lasts
+    // `windowMinutes` (a window may run past midnight; at most one day). `slotMinutes` must
+    // divide 60. Throws std::invalid_argument for other settings.
+    TimeGrid(int days, int slotMinutes = 60, int windowStart = 18 * 60, int windowMinutes = 24 * 60);
+
+    int days() const { return dayCount; }
+    int slotMinutes() const { return slotLength; }
+    int windowStart() const { return startMinute; }
+    int slotsPerDay() const { return daySlots; }
+    int slotsPerHour() const { return 60 / slotLength; }
+
+    bool isFree(int day, int slot) const;
+
+    // Mark `count` slots from `firstSlot` busy; the range is clipped to the window
+    void block(int day, int firstSlot, int count);
+
+    // Free slots of the day and the whole study hours they add up to
+    int freeSlots(int day) const;
+    int freeHours(int day) const { return freeSlots(day) / slotsPerHour(); }
+
+    // First free (or busy) slot at or after `fromSlot`, or slotsPerDay() if there is none
+    int nextFree(int day, int fromSlot) const;
+    int nextBusy(int day, int fromSlot) const;
+
+    // Take the earliest `count` free slots of the day, marking them busy. Returns them as
+    // contiguous runs; fewer slots are taken if the day runs out of free time.
+    std::vector<SlotRun> take(int day, int count);
+
+    // Minutes after midnight of the day at which a slot starts; past 1440 for windows crossing midnight
+    int minuteOf(int slot) const { return startMinute + slot * slotLength; }
+
+private:
+    int dayCount;
+    int slotLength;
+    int startMinute;
+    int daySlots;
+    int wordsPerDay;
+    std::vector<std::uint64_t> words; // wordsPerDay words per day, bits past the window stay clear
+
+    int scan(int day, int fromSlot, bool busy) const;
+};
+
+#endif // TIMEGRID_HPP
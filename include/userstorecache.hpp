@@ -0,0 +1,94 @@
+#ifndef USERSTORECACHE_HPP
+#define USERSTORECACHE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include "assignmentstore.hpp"
+
+// Least-recently-used cache of users' assignment stores with a memory budget.
+// Stores are loaded from <dataDirectory>/<user>.json on a miss. Modified stores
+// are marked dirty and written back when evicted, flushed or when the cache is destroyed,
+// and also after a number of changes or once they have been dirty for a while
+// (see setWriteBack and flushExpired), which bounds what a crash can lose.
+// A store whose write fails stays dirty and cached, and is retried later.
+class UserStoreCache {
+public:
+    static constexpr std::size_t DefaultByteBudget = 64 * 1024 * 1024;
+
+    // Cache counters
+    struct Stats {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t evictions = 0;
+        std::size_t saves = 0;
+        std::size_t failedSaves = 0;
+    };
+
+    static constexpr std::size_t DefaultWriteBackChanges = 16;
+    static constexpr std::chrono::milliseconds DefaultWriteBackDelay{2000};
+
+    explicit UserStoreCache(std::size_t byteBudget = DefaultByteBudget, std::string dataDirectory = "Data");
+
+    // Writes back every dirty store
+    ~UserStoreCache();
+
+    UserStoreCache(const UserStoreCache&) = delete;
+    UserStoreCache& operator=(const UserStoreCache&) = delete;
+
+    // Store of a user, loading it on a miss. The reference stays valid until the next get().
+    // Throws FileException, caching nothing, when the user's file exists but cannot be loaded.
+    AssignmentStore& get(const std::string& user);
+
+    // Record that a user's store changed; re-measures it and evicts other stores if over budget
+    void markDirty(const std::string& user);
+
+    // Write back every dirty store
+    void flush();
+
+    // Write back a store once it has `maxChanges` unsaved changes or has been dirty for `maxDelay`
+    void setWriteBack(std::size_t maxChanges, std::chrono::milliseconds maxDelay);
+
+    // Write back stores that have been dirty for longer than the write-back delay; call regularly
+    void flushExpired();
+
+    // Path of a user's file
+    std::string userFile(const std::string& user) const;
+
+    std::size_t size() const;
+    std::size_t bytesUsed() const;
+    std::size_t byteBudget() const;
+    bool contains(const std::string& user) const;
+    bool isDirty(const std::string& user) const;
+    const Stats& stats() const;
+
+private:
+    struct Entry {
+        std::string user;
+        AssignmentStore store;
+        std::size_t bytes = 0;
+        bool dirty = false;
+        std::size_t changes = 0;                     // Unsaved markDirty calls
+        std::chrono::steady_clock::time_point since; // When the store became dirty or last failed to save
+    };
+
+    std::size_t budget;
+    std::string dataDirectory;
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> lookup;
+    std::size_t usedBytes = 0;
+    std::size_t writeBackChanges = DefaultWriteBackChanges;
+    std::chrono::milliseconds writeBackDelay = DefaultWriteBackDelay;
+    Stats counters;
+
+    // Returns false, leaving the entry dirty, when the write fails
+    bool save(Entry& entry);
+
+    // Evict least recently used stores, never the most recent one, until within budget;
+    // dirty stores that cannot be saved are kept
+    void enforceBudget();
+};
+
+#endif // USERSTORECACHE_HPP
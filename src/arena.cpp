@@ -0,0 +1,89 @@
+#include "../include/arena.hpp"
+#include <algorithm>
+#include <new>
+
+namespace {
+    // First block a thread gets, and the largest it keeps between scheduler runs
+    constexpr std::size_t InitialThreadBlock = 16 * 1024;
+    constexpr std::size_t MaxThreadBlock = 16 * 1024 * 1024;
+
+    // The calling thread's scratch block
+    struct ThreadBlock {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size = 0;
+        bool inUse = false;
+    };
+
+    ThreadBlock& threadBlock() {
+        thread_local ThreadBlock block;
+        return block;
+    }
+}
+
+AssignmentArena::AssignmentArena(std::size_t initialBytes)
+    : resource(std::make_shared<std::pmr::monotonic_buffer_resource>(std::max<std::size_t>(initialBytes, 1))) {}
+
+bool AssignmentArena::pinned() const {
+    return resource.use_count() > 1; // Every control block made from the arena holds a reference
+}
+
+std::size_t AssignmentArena::initialBytesForFile(std::size_t fileBytes) {
+    // A saved assignment takes roughly 200 bytes of JSON and 100 bytes in memory
+    return std::clamp<std::size_t>(fileBytes / 2, 1024, 4 * 1024 * 1024);
+}
+
+void AssignmentArena::moveToHeap(std::vector<std::shared_ptr<Assignment>>& assignments) {
+    for (auto& assignment : assignments)
+        assignment = std::make_shared<Assignment>(std::move(*assignment));
+}
+
+ScratchArena::ScratchArena() {
+    ThreadBlock& block = threadBlock();
+    if (block.inUse) {
+        // Nested run on this thread: the outer arena owns the block
+        arena.emplace(&overflow);
+        return;
+    }
+
+    if (!block.data) {
+        block.data.reset(new std::byte[InitialThreadBlock]);
+        block.size = InitialThreadBlock;
+    }
+    block.inUse = true;
+    ownsThreadBlock = true;
+    arena.emplace(block.data.get(), block.size, &overflow);
+}
+
+ScratchArena::~ScratchArena() {
+    arena.reset(); // Returns overflow blocks before the thread block is resized
+    if (!ownsThreadBlock)
+        return;
+
+    ThreadBlock& block = threadBlock();
+    block.inUse = false;
+    if (overflow.allocated > 0 && block.size < MaxThreadBlock) {
+        block.size = std::min(MaxThreadBlock, block.size + overflow.allocated);
+        block.data.reset(new std::byte[block.size]);
+    }
+}
+
+std::pmr::memory_resource* ScratchArena::resource() {
+    return &*arena;
+}
+
+std::size_t ScratchArena::threadBlockSize() {
+    return threadBlock().size;
+}
+
+void* ScratchArena::OverflowResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    allocated += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void ScratchArena::OverflowResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool ScratchArena::OverflowResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
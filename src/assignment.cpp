@@ -1,36 +1,39 @@
 #include "../include/assignment.hpp"
+#include "../include/assignmentrenderer.hpp"
+#include "../include/logger.hpp"
 
 // Default constructor
 Assignment::Assignment()
-    : subject("N/A"), name("N/A"), deadline(0), duration(1), weight(0.0f),
+    : id(0), subjectId(SubjectTable::global().intern("N/A")), name("N/A"), deadline(0), duration(1), weight(0.0f),
       size(3), groupWork(false), groupSize(1), realDuration(1), priority(0) {}
 
 // Parameterized constructor
 Assignment::Assignment(const std::string& subject, const std::string& name, int deadline,
                        int duration, float weight, int size, bool groupWork, int groupSize)
-    : subject(subject), name(name), deadline(deadline), duration(duration), weight(weight),
+    : id(0), subjectId(SubjectTable::global().intern(subject)), name(name), deadline(deadline), duration(duration), weight(weight),
       size(size), groupWork(groupWork), groupSize(groupSize), realDuration(duration / groupSize), priority(0) {}
 
 // Copy constructor
 Assignment::Assignment(const Assignment& other)
-    : subject(other.subject), name(other.name), deadline(other.deadline), duration(other.duration),
+    : id(other.id), subjectId(other.subjectId), name(other.name), deadline(other.deadline), duration(other.duration),
       weight(other.weight), size(other.size), groupWork(other.groupWork),
       groupSize(other.groupSize), realDuration(other.realDuration), priority(other.priority) {
-    std::cout << "Copy constructor called." << std::endl;
+    LOG_TRACE("Copy constructor called.");
 }
 
 // Move constructor
 Assignment::Assignment(Assignment&& other) noexcept
-    : subject(std::move(other.subject)), name(std::move(other.name)), deadline(other.deadline),
+    : id(other.id), subjectId(other.subjectId), name(std::move(other.name)), deadline(other.deadline),
       duration(other.duration), weight(other.weight), size(other.size),
       groupWork(other.groupWork), groupSize(other.groupSize), realDuration(other.realDuration), priority(other.priority) {
-    std::cout << "Move constructor called." << std::endl;
+    LOG_TRACE("Move constructor called.");
 }
 
 // Copy assignment operator
 Assignment& Assignment::operator=(const Assignment& other) {
     if (this != &other) {
-        subject = other.subject;
+        id = other.id;
+        subjectId = other.subjectId;
         name = other.name;
         deadline = other.deadline;
         duration = other.duration;
@@ -40,7 +43,7 @@ Assignment& Assignment::operator=(const Assignment& other) {
         groupSize = other.groupSize;
         realDuration = other.realDuration;
         priority = other.priority;
-        std::cout << "Copy assignment operator called." << std::endl;
+        LOG_TRACE("Copy assignment operator called.");
     }
     return *this;
 }
@@ -48,7 +51,8 @@ Assignment& Assignment::operator=(const Assignment& other) {
 // Move assignment operator
 Assignment& Assignment::operator=(Assignment&& other) noexcept {
     if (this != &other) {
-        subject = std::move(other.subject);
+        id = other.id;
+        subjectId = other.subjectId;
         name = std::move(other.name);
         deadline = other.deadline;
         duration = other.duration;
@@ -58,16 +62,20 @@ Assignment& Assignment::operator=(Assignment&& other) noexcept {
         groupSize = other.groupSize;
         realDuration = other.realDuration;
         priority = other.priority;
-        std::cout << "Move assignment operator called." << std::endl;
+        LOG_TRACE("Move assignment operator called.");
     }
     return *this;
 }
 
 // Destructor
 Assignment::~Assignment() {
-    std::cout << "Destructor called for " << name << "." << std::endl;
+    LOG_TRACE("Destructor called for " << name << ".");
 }
 
+// Setter and Getter for the persistent id
+void Assignment::setId(AssignmentId id) { this->id = id; }
+AssignmentId Assignment::getId() const { return id; }
+
 // Setters and Getters for Priority
 void Assignment::setPriority(int priority) { this->priority = priority; }
 int Assignment::getPriority() const { return priority; }
@@ -77,7 +85,8 @@ void Assignment::decreaseDuration(int hours) { realDuration -= hours; }
 void Assignment::decreaseDeadline(int days) { deadline -= days; }
 
 // Getters for private members
-const std::string& Assignment::getSubject() const { return subject; }
+const std::string& Assignment::getSubject() const { return SubjectTable::global().name(subjectId); }
+SubjectId Assignment::getSubjectId() const { return subjectId; }
 const std::string& Assignment::getName() const { return name; }
 int Assignment::getDeadline() const { return deadline; }
 int Assignment::getDuration() const { return duration; }
@@ -89,14 +98,11 @@ int Assignment::getRealDuration() const { return realDuration; }
 
 // Display function
 void Assignment::display() const {
-    std::cout << "Subject: " << subject << "\n"
-              << "Name: " << name << "\n"
-              << "Deadline: " << deadline << " days\n"
-              << "Duration: " << duration << " hours\n"
-              << "Weight: " << weight << "%\n"
-              << "Size: " << size << "\n"
-              << "Group Work: " << (groupWork ? "Yes" : "No") << "\n"
-              << "Group Size: " << groupSize << "\n"
-              << "Real Duration: " << realDuration << " hours\n"
-              << "Priority: " << priority << "\n";
+    OutputBuffer buffer(std::cout);
+    AssignmentRenderer::appendDetails(buffer, *this);
+}
+
+// Validation of imported fields
+bool Assignment::validFields(int deadline, int duration, int size, int groupSize) {
+    return groupSize >= 1 && deadline >= 0 && duration >= 0 && size >= 0;
 }
@@ -0,0 +1,301 @@
+#include "../include/assignmentparser.hpp"
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    enum Field : int {
+        Subject, Name, Deadline, Duration, Weight, Size, GroupWork, GroupSize, Id, User, FieldCount
+    };
+
+    constexpr unsigned RequiredFields = (1u << Id) - 1; // Everything but the id and user
+
+    // Perfect hash over the schema keys: (6 * length + first + last byte) mod 17
+    constexpr int HashSlots = 17;
+
+    int keyHash(std::string_view key) {
+        return static_cast<int>((6 * key.size() + static_cast<unsigned char>(key.front()) +
+                                 static_cast<unsigned char>(key.back())) % HashSlots);
+    }
+
+    struct KeySlot {
+        const char* key;
+        int field;
+    };
+
+    // Slot table generated from keyHash; empty slots hold nullptr
+    constexpr KeySlot KeyTable[HashSlots] = {
+        {"user", User},         {"subject", Subject},     {"size", Size},
+        {"duration", Duration}, {nullptr, -1},            {nullptr, -1},
+        {nullptr, -1},          {nullptr, -1},            {nullptr, -1},
+        {"group_size", GroupSize}, {nullptr, -1},         {"deadline", Deadline},
+        {nullptr, -1},          {"id", Id},               {"name", Name},
+        {"group_work", GroupWork}, {"weight", Weight}
+    };
+
+    int lookupField(std::string_view key) {
+        if (key.empty())
+            return -1;
+        const KeySlot& slot = KeyTable[keyHash(key)];
+        if (!slot.key || std::strlen(slot.key) != key.size() || std::memcmp(slot.key, key.data(), key.size()) != 0)
+            return -1;
+        return slot.field;
+    }
+
+    void appendUtf8(std::string& out, std::uint32_t codePoint) {
+        if (codePoint < 0x80) {
+            out.push_back(static_cast<char>(codePoint));
+        } else if (codePoint < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+
+    // Cursor over the input; every method returns false when the input leaves the fast path
+    class Scanner {
+    public:
+        explicit Scanner(std::string_view text) : p(text.data()), end(text.data() + text.size()) {}
+
+        void skipSpace() {
+            while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+                ++p;
+        }
+
+        bool atEnd() {
+            skipSpace();
+            return p == end;
+        }
+
+        bool consume(char c) {
+            skipSpace();
+            if (p == end || *p != c)
+                return false;
+            ++p;
+            return true;
+        }
+
+        bool peek(char c) {
+            skipSpace();
+            return p < end && *p == c;
+        }
+
+        // String value; escaped strings are decoded into `scratch`
+        bool string(std::string_view& value, std::string& scratch, bool& escaped) {
+            if (!consume('"'))
+                return false;
+
+            const char* start = p;
+            while (p < end && *p != '"' && *p != '\\') {
+                if (static_cast<unsigned char>(*p) < 0x20)
+                    return false;
+                ++p;
+            }
+            if (p == end)
+                return false;
+            if (*p == '"') {
+                value = std::string_view(start, static_cast<std::size_t>(p - start));
+                escaped = false;
+                ++p;
+                return true;
+            }
+
+            scratch.assign(start, p);
+            while (p < end && *p != '"') {
+                char c = *p++;
+                if (static_cast<unsigned char>(c) < 0x20)
+                    return false;
+                if (c != '\\') {
+                    scratch.push_back(c);
+                    continue;
+                }
+                if (p == end)
+                    return false;
+                switch (*p++) {
+                    case '"': scratch.push_back('"'); break;
+                    case '\\': scratch.push_back('\\'); break;
+                    case '/': scratch.push_back('/'); break;
+                    case 'b': scratch.push_back('\b'); break;
+                    case 'f': scratch.push_back('\f'); break;
+                    case 'n': scratch.push_back('\n'); break;
+                    case 'r': scratch.push_back('\r'); break;
+                    case 't': scratch.push_back('\t'); break;
+                    case 'u': {
+                        std::uint32_t codePoint;
+                        if (!hex4(codePoint))
+                            return false;
+                        if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                            std::uint32_t low;
+                            if (end - p < 2 || p[0] != '\\' || p[1] != 'u')
+                                return false;
+                            p += 2;
+                            if (!hex4(low) || low < 0xDC00 || low > 0xDFFF)
+                                return false;
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                            return false;
+                        }
+                        appendUtf8(scratch, codePoint);
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+            }
+            if (p == end)
+                return false;
+            ++p;
+            value = scratch;
+            escaped = true;
+            return true;
+        }
+
+        // Plain JSON integer (no fraction or exponent)
+        template <typename Integer>
+        bool integer(Integer& value) {
+            skipSpace();
+            if (p == end || (*p != '-' && (*p < '0' || *p > '9')))
+                return false;
+            auto result = std::from_chars(p, end, value);
+            if (result.ec != std::errc() || !numberEnds(result.ptr))
+                return false;
+            p = result.ptr;
+            return true;
+        }
+
+        // Any JSON number, rounded through double as nlohmann's get<float>() does
+        bool number(float& value) {
+            skipSpace();
+            if (p == end || (*p != '-' && (*p < '0' || *p > '9')))
+                return false;
+            double parsed;
+            auto result = std::from_chars(p, end, parsed, std::chars_format::general);
+            if (result.ec != std::errc() || !numberEnds(result.ptr))
+                return false;
+            p = result.ptr;
+            value = static_cast<float>(parsed);
+            return true;
+        }
+
+        bool boolean(bool& value) {
+            skipSpace();
+            if (end - p >= 4 && std::memcmp(p, "true", 4) == 0) {
+                value = true;
+                p += 4;
+                return true;
+            }
+            if (end - p >= 5 && std::memcmp(p, "false", 5) == 0) {
+                value = false;
+                p += 5;
+                return true;
+            }
+            return false;
+        }
+
+    private:
+        const char* p;
+        const char* end;
+
+        // A number must be followed by a delimiter, not by more number characters
+        bool numberEnds(const char* q) const {
+            return q == end || !(*q == '.' || *q == 'e' || *q == 'E' || (*q >= '0' && *q <= '9'));
+        }
+
+        bool hex4(std::uint32_t& value) {
+            if (end - p < 4)
+                return false;
+            value = 0;
+            for (int i = 0; i < 4; ++i) {
+                char c = *p++;
+                value <<= 4;
+                if (c >= '0' && c <= '9') value |= static_cast<std::uint32_t>(c - '0');
+                else if (c >= 'a' && c <= 'f') value |= static_cast<std::uint32_t>(c - 'a' + 10);
+                else if (c >= 'A' && c <= 'F') value |= static_cast<std::uint32_t>(c - 'A' + 10);
+                else return false;
+            }
+            return true;
+        }
+    };
+
+    // Scratch space for strings that had escapes
+    struct Scratch {
+        std::string subject, name, user, key;
+    };
+
+    // One assignment object; `withUser` makes the user field required, otherwise it is rejected
+    bool parseObject(Scanner& in, AssignmentParser::Record& record, Scratch& scratch, bool withUser) {
+        if (!in.consume('{'))
+            return false;
+
+        record = AssignmentParser::Record();
+        unsigned seen = 0;
+        if (!in.peek('}')) {
+            do {
+                std::string_view key;
+                bool keyEscaped;
+                if (!in.string(key, scratch.key, keyEscaped) || !in.consume(':'))
+                    return false;
+
+                int field = lookupField(key);
+                if (field < 0 || (seen & (1u << field)) || (field == User && !withUser))
+                    return false; // Unknown or repeated key
+                seen |= 1u << field;
+
+                bool ok = false;
+                switch (field) {
+                    case Subject: ok = in.string(record.subject, scratch.subject, record.subjectEscaped); break;
+                    case Name: ok = in.string(record.name, scratch.name, record.nameEscaped); break;
+                    case Deadline: ok = in.integer(record.deadline); break;
+                    case Duration: ok = in.integer(record.duration); break;
+                    case Weight: ok = in.number(record.weight); break;
+                    case Size: ok = in.integer(record.size); break;
+                    case GroupWork: ok = in.boolean(record.groupWork); break;
+                    case GroupSize: ok = in.integer(record.groupSize); break;
+                    case Id: ok = in.integer(record.id); break;
+                    case User: ok = in.string(record.user, scratch.user, record.userEscaped); break;
+                }
+                if (!ok)
+                    return false;
+            } while (in.consume(','));
+        }
+
+        const unsigned required = withUser ? RequiredFields | (1u << User) : RequiredFields;
+        return in.consume('}') && (seen & required) == required;
+    }
+}
+
+bool AssignmentParser::parseArray(std::string_view text, const RecordCallback& onRecord) {
+    Scanner in(text);
+    if (!in.consume('['))
+        return false;
+
+    Record record;
+    Scratch scratch;
+    if (!in.peek(']')) {
+        do {
+            if (!parseObject(in, record, scratch, false))
+                return false;
+            onRecord(record);
+        } while (in.consume(','));
+    }
+
+    return in.consume(']') && in.atEnd();
+}
+
+bool AssignmentParser::parseLine(std::string_view line, const RecordCallback& onRecord) {
+    Scanner in(line);
+    Record record;
+    Scratch scratch;
+    if (!parseObject(in, record, scratch, true) || !in.atEnd())
+        return false;
+    onRecord(record);
+    return true;
+}
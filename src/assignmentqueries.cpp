@@ -0,0 +1,61 @@
+#include "../include/assignmentqueries.hpp"
+#include <algorithm>
+
+namespace {
+    using AssignmentPtr = AssignmentQueries::AssignmentPtr;
+
+    // Select the first k positions under `less` (ties by position) without sorting the rest
+    template <typename Less>
+    std::vector<AssignmentPtr> selectTop(const std::vector<AssignmentPtr>& assignments, std::size_t k, Less less) {
+        std::vector<std::size_t> order(assignments.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+
+        auto compare = [&](std::size_t a, std::size_t b) {
+            if (less(*assignments[a], *assignments[b]))
+                return true;
+            if (less(*assignments[b], *assignments[a]))
+                return false;
+            return a < b;
+        };
+
+        if (k >= order.size()) {
+            std::sort(order.begin(), order.end(), compare);
+        } else {
+            std::partial_sort(order.begin(), order.begin() + k, order.end(), compare);
+            order.resize(k);
+        }
+
+        std::vector<AssignmentPtr> result;
+        result.reserve(order.size());
+        for (std::size_t index : order)
+            result.push_back(assignments[index]);
+        return result;
+    }
+}
+
+std::vector<AssignmentPtr> AssignmentQueries::soonestDeadlines(const std::vector<AssignmentPtr>& assignments, std::size_t k) {
+    return selectTop(assignments, k, [](const Assignment& a, const Assignment& b) {
+        return a.getDeadline() < b.getDeadline();
+    });
+}
+
+std::vector<AssignmentPtr> AssignmentQueries::longestDurations(const std::vector<AssignmentPtr>& assignments, std::size_t k) {
+    return selectTop(assignments, k, [](const Assignment& a, const Assignment& b) {
+        return a.getDuration() > b.getDuration();
+    });
+}
+
+std::vector<AssignmentPtr> AssignmentQueries::dueWithin(const std::vector<AssignmentPtr>& assignments, int days) {
+    // Only the matches are ordered
+    std::vector<AssignmentPtr> matches;
+    for (const auto& assignment : assignments) {
+        if (assignment->getDeadline() <= days)
+            matches.push_back(assignment);
+    }
+
+    std::stable_sort(matches.begin(), matches.end(), [](const AssignmentPtr& a, const AssignmentPtr& b) {
+        return a->getDeadline() < b->getDeadline();
+    });
+    return matches;
+}
@@ -0,0 +1,144 @@
+#include "../include/assignmentrenderer.hpp"
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Column widths of the table layout
+    constexpr std::size_t SubjectWidth = 16;
+    constexpr std::size_t NameWidth = 28;
+    constexpr std::size_t NumberWidth = 9;
+
+    // TSV fields cannot contain tabs or line breaks
+    void appendTsvField(OutputBuffer& buffer, std::string_view text) {
+        for (char c : text)
+            buffer.append((c == '\t' || c == '\n' || c == '\r') ? ' ' : c);
+    }
+
+    template <typename Number>
+    void appendNumberColumn(OutputBuffer& buffer, Number value, std::string_view suffix = {}) {
+        char digits[32];
+        char* end = std::to_chars(digits, digits + 24, value).ptr;
+        for (char c : suffix)
+            *end++ = c;
+        buffer.appendPadded(std::string_view(digits, end - digits), NumberWidth);
+    }
+
+    // Same float formatting as the detailed layout, so 12.5 is not cut to 12
+    void appendFloatColumn(OutputBuffer& buffer, float value, std::string_view suffix = {}) {
+        char digits[40];
+        char* end = std::to_chars(digits, digits + 32, value, std::chars_format::general, 6).ptr;
+        for (char c : suffix)
+            *end++ = c;
+        buffer.appendPadded(std::string_view(digits, end - digits), NumberWidth);
+    }
+}
+
+AssignmentRenderer::Layout AssignmentRenderer::parseLayout(std::string_view name) {
+    if (name == "detailed")
+        return Layout::Detailed;
+    if (name == "table")
+        return Layout::Table;
+    if (name == "tsv")
+        return Layout::Tsv;
+    if (name == "ndjson")
+        return Layout::Ndjson;
+    throw std::invalid_argument("Unknown display layout: " + std::string(name));
+}
+
+AssignmentRenderer::AssignmentRenderer(std::ostream& out, Layout layout)
+    : layout(layout), buffer(out) {}
+
+void AssignmentRenderer::text(std::string_view message) {
+    if (layout == Layout::Detailed || layout == Layout::Table)
+        buffer.append(message);
+}
+
+void AssignmentRenderer::appendDetails(OutputBuffer& buffer, const Assignment& assignment) {
+    buffer.append("Subject: ").append(assignment.getSubject())
+          .append("\nName: ").append(assignment.getName())
+          .append("\nDeadline: ").appendInt(assignment.getDeadline())
+          .append(" days\nDuration: ").appendInt(assignment.getDuration())
+          .append(" hours\nWeight: ").appendFloat(assignment.getWeight())
+          .append("%\nSize: ").appendInt(assignment.getSize())
+          .append("\nGroup Work: ").append(assignment.isGroupWork() ? "Yes" : "No")
+          .append("\nGroup Size: ").appendInt(assignment.getGroupSize())
+          .append("\nReal Duration: ").appendInt(assignment.getRealDuration())
+          .append(" hours\nPriority: ").appendInt(assignment.getPriority())
+          .append('\n');
+}
+
+void AssignmentRenderer::header() {
+    headerWritten = true;
+    if (layout == Layout::Table) {
+        buffer.appendPadded("Id", NumberWidth)
+              .appendPadded("Subject", SubjectWidth).append(' ')
+              .appendPadded("Name", NameWidth).append(' ')
+              .appendPadded("Deadline", NumberWidth).appendPadded("Hours", NumberWidth)
+              .appendPadded("Weight", NumberWidth).appendPadded("Size", NumberWidth)
+              .appendPadded("Group", NumberWidth).appendPadded("Real", NumberWidth)
+              .append("Priority\n");
+    } else if (layout == Layout::Tsv) {
+        buffer.append("id\tsubject\tname\tdeadline\tduration\tweight\tsize\tgroup_work\tgroup_size\treal_duration\tpriority\n");
+    }
+}
+
+void AssignmentRenderer::row(const Assignment& assignment) {
+    if (!headerWritten)
+        header();
+
+    switch (layout) {
+        case Layout::Detailed:
+            appendDetails(buffer, assignment);
+            buffer.append("---------------------------\n");
+            break;
+        case Layout::Table: {
+            appendNumberColumn(buffer, assignment.getId());
+            buffer.appendPadded(assignment.getSubject(), SubjectWidth).append(' ')
+                  .appendPadded(assignment.getName(), NameWidth).append(' ');
+            appendNumberColumn(buffer, assignment.getDeadline());
+            appendNumberColumn(buffer, assignment.getDuration());
+            appendFloatColumn(buffer, assignment.getWeight(), "%");
+            appendNumberColumn(buffer, assignment.getSize());
+            appendNumberColumn(buffer, assignment.isGroupWork() ? assignment.getGroupSize() : 1);
+            appendNumberColumn(buffer, assignment.getRealDuration());
+            buffer.appendInt(assignment.getPriority()).append('\n');
+            break;
+        }
+        case Layout::Tsv:
+            buffer.appendUnsigned(assignment.getId()).append('\t');
+            appendTsvField(buffer, assignment.getSubject());
+            buffer.append('\t');
+            appendTsvField(buffer, assignment.getName());
+            buffer.append('\t').appendInt(assignment.getDeadline())
+                  .append('\t').appendInt(assignment.getDuration())
+                  .append('\t').appendShortestFloat(assignment.getWeight())
+                  .append('\t').appendInt(assignment.getSize())
+                  .append('\t').append(assignment.isGroupWork() ? "true" : "false")
+                  .append('\t').appendInt(assignment.getGroupSize())
+                  .append('\t').appendInt(assignment.getRealDuration())
+                  .append('\t').appendInt(assignment.getPriority())
+                  .append('\n');
+            break;
+        case Layout::Ndjson:
+            buffer.append("{\"id\":").appendUnsigned(assignment.getId())
+                  .append(",\"subject\":").appendJsonString(assignment.getSubject())
+                  .append(",\"name\":").appendJsonString(assignment.getName())
+                  .append(",\"deadline\":").appendInt(assignment.getDeadline())
+                  .append(",\"duration\":").appendInt(assignment.getDuration())
+                  .append(",\"weight\":").appendShortestFloat(assignment.getWeight())
+                  .append(",\"size\":").appendInt(assignment.getSize())
+                  .append(",\"group_work\":").append(assignment.isGroupWork() ? "true" : "false")
+                  .append(",\"group_size\":").appendInt(assignment.getGroupSize())
+                  .append(",\"real_duration\":").appendInt(assignment.getRealDuration())
+                  .append(",\"priority\":").appendInt(assignment.getPriority())
+                  .append("}\n");
+            break;
+    }
+
+    buffer.flushIfFull();
+}
+
+void AssignmentRenderer::finish() {
+    buffer.flush();
+}
@@ -0,0 +1,226 @@
+#include "../include/assignmentstore.hpp"
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    // Never handed out, so the id after it cannot wrap to 0
+    constexpr AssignmentId ReservedId = std::numeric_limits<AssignmentId>::max();
+}
+
+AssignmentStore::AssignmentStore(std::vector<AssignmentPtr> assignments) {
+    this->assignments.reserve(assignments.size());
+    for (auto& assignment : assignments)
+        add(std::move(assignment));
+}
+
+AssignmentId AssignmentStore::add(AssignmentPtr assignment) {
+    AssignmentId id = assignment->getId();
+    if (id == 0 || id == ReservedId || positions.count(id))
+        assignment->setId(id = freshId());
+    if (id >= nextId)
+        nextId = id + 1;
+
+    Slot slot;
+    slot.list = assignments.size();
+    indexAssignment(assignment, slot);
+    positions.emplace(id, slot);
+    assignments.push_back(std::move(assignment));
+    return id;
+}
+
+bool AssignmentStore::remove(AssignmentId id) {
+    auto found = positions.find(id);
+    if (found == positions.end())
+        return false;
+
+    AssignmentPtr& entry = assignments[found->second.list];
+    unindexAssignment(entry, found->second);
+    positions.erase(found);
+
+    // Leave a tombstone so later assignments keep their order
+    entry = nullptr;
+    if (++removed * 2 > assignments.size())
+        compact();
+    return true;
+}
+
+bool AssignmentStore::update(AssignmentId id, AssignmentPtr replacement) {
+    auto found = positions.find(id);
+    if (found == positions.end())
+        return false;
+
+    AssignmentPtr& entry = assignments[found->second.list];
+    replacement->setId(id);
+    if (replacement->getSubjectId() != entry->getSubjectId()) {
+        unindexAssignment(entry, found->second);
+        entry = std::move(replacement);
+        indexAssignment(entry, found->second);
+        return true;
+    }
+
+    // Same subject: keep the posting position too
+    unindexOrdered(entry);
+    SubjectPosting& posting = subjectIndex[entry->getSubjectId()];
+    posting.totalHours += replacement->getDuration() - entry->getDuration();
+    posting.assignments[found->second.posting] = replacement;
+    entry = std::move(replacement);
+    indexOrdered(entry);
+    return true;
+}
+
+AssignmentStore::AssignmentPtr AssignmentStore::find(AssignmentId id) const {
+    auto found = positions.find(id);
+    return found != positions.end() ? assignments[found->second.list] : nullptr;
+}
+
+void AssignmentStore::removeAt(std::size_t index) {
+    compact();
+    if (index >= assignments.size())
+        throw std::out_of_range("Assignment index out of range: " + std::to_string(index));
+
+    remove(assignments[index]->getId());
+}
+
+const std::vector<AssignmentStore::AssignmentPtr>& AssignmentStore::all() const {
+    compact();
+    return assignments;
+}
+
+const AssignmentStore::AssignmentPtr& AssignmentStore::at(std::size_t index) const {
+    compact();
+    return assignments.at(index);
+}
+
+std::size_t AssignmentStore::size() const { return assignments.size() - removed; }
+bool AssignmentStore::empty() const { return size() == 0; }
+
+std::size_t AssignmentStore::memoryUsage() const {
+    // Tree nodes carry three pointers and a color next to the key/value pair
+    constexpr std::size_t TreeNodeOverhead = 4 * sizeof(void*);
+    constexpr std::size_t SharedControlBlock = 2 * sizeof(void*);
+
+    std::size_t bytes = sizeof(*this) + assignments.capacity() * sizeof(AssignmentPtr);
+    bytes += positions.size() * (sizeof(decltype(positions)::value_type) + 2 * sizeof(void*));
+    for (const auto& assignment : assignments) {
+        if (!assignment)
+            continue;
+        bytes += sizeof(Assignment) + SharedControlBlock;
+        if (assignment->getName().capacity() > 15) // Longer names leave the small-string buffer
+            bytes += assignment->getName().capacity() + 1;
+    }
+    bytes += deadlineIndex.size() * (sizeof(DeadlineIndex::value_type) + TreeNodeOverhead);
+    bytes += durationIndex.size() * (sizeof(DurationIndex::value_type) + TreeNodeOverhead);
+    for (const auto& subject : subjectIndex)
+        bytes += sizeof(SubjectIndex::value_type) + 2 * sizeof(void*) + subject.second.assignments.capacity() * sizeof(AssignmentPtr);
+    return bytes;
+}
+
+const AssignmentStore::DeadlineIndex& AssignmentStore::byDeadline() const { return deadlineIndex; }
+const AssignmentStore::DurationIndex& AssignmentStore::byDuration() const { return durationIndex; }
+
+const std::vector<AssignmentStore::AssignmentPtr>& AssignmentStore::bySubject(const std::string& subject) const {
+    static const std::vector<AssignmentPtr> none;
+    const SubjectPosting* posting = subjectPosting(SubjectTable::global().find(subject));
+    return posting ? posting->assignments : none;
+}
+
+const AssignmentStore::SubjectPosting* AssignmentStore::subjectPosting(SubjectId subject) const {
+    auto it = subjectIndex.find(subject);
+    if (it == subjectIndex.end())
+        return nullptr;
+    compactPosting(it->second);
+    return &it->second;
+}
+
+const AssignmentStore::SubjectIndex& AssignmentStore::bySubjectId() const {
+    for (auto it = subjectIndex.begin(); postingsRemoved > 0 && it != subjectIndex.end(); ++it)
+        compactPosting(it->second);
+    return subjectIndex;
+}
+
+AssignmentId AssignmentStore::freshId() const {
+    if (nextId != ReservedId)
+        return nextId;
+
+    // A loaded id just below the maximum used up the range above it: reuse the lowest free id
+    AssignmentId id = 1;
+    while (positions.count(id))
+        ++id;
+    return id;
+}
+
+void AssignmentStore::compact() const {
+    if (removed == 0)
+        return;
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < assignments.size(); ++i) {
+        if (!assignments[i])
+            continue;
+        positions[assignments[i]->getId()].list = kept;
+        if (i != kept)
+            assignments[kept] = std::move(assignments[i]);
+        ++kept;
+    }
+    assignments.resize(kept);
+    removed = 0;
+}
+
+void AssignmentStore::compactPosting(SubjectPosting& posting) const {
+    if (posting.removed == 0)
+        return;
+
+    auto& postings = posting.assignments;
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < postings.size(); ++i) {
+        if (!postings[i])
+            continue;
+        positions[postings[i]->getId()].posting = kept;
+        if (i != kept)
+            postings[kept] = std::move(postings[i]);
+        ++kept;
+    }
+    postings.resize(kept);
+    postingsRemoved -= posting.removed;
+    posting.removed = 0;
+}
+
+void AssignmentStore::indexOrdered(const AssignmentPtr& assignment) {
+    deadlineIndex.emplace(IndexKey(assignment->getDeadline(), assignment->getId()), assignment);
+    durationIndex.emplace(IndexKey(assignment->getDuration(), assignment->getId()), assignment);
+}
+
+void AssignmentStore::unindexOrdered(const AssignmentPtr& assignment) {
+    deadlineIndex.erase(IndexKey(assignment->getDeadline(), assignment->getId()));
+    durationIndex.erase(IndexKey(assignment->getDuration(), assignment->getId()));
+}
+
+void AssignmentStore::indexAssignment(const AssignmentPtr& assignment, Slot& slot) {
+    indexOrdered(assignment);
+
+    SubjectPosting& posting = subjectIndex[assignment->getSubjectId()];
+    slot.posting = posting.assignments.size();
+    posting.assignments.push_back(assignment);
+    posting.totalHours += assignment->getDuration();
+}
+
+void AssignmentStore::unindexAssignment(const AssignmentPtr& assignment, const Slot& slot) {
+    unindexOrdered(assignment);
+
+    auto posting = subjectIndex.find(assignment->getSubjectId());
+    if (posting == subjectIndex.end())
+        return;
+
+    // Tombstone the posting entry; compacted on the next read of the posting
+    SubjectPosting& entry = posting->second;
+    entry.assignments[slot.posting] = nullptr;
+    entry.totalHours -= assignment->getDuration();
+    ++entry.removed;
+    ++postingsRemoved;
+    if (entry.removed == entry.assignments.size()) {
+        postingsRemoved -= entry.removed;
+        subjectIndex.erase(posting);
+    } else if (entry.removed * 2 > entry.assignments.size()) {
+        compactPosting(entry);
+    }
+}
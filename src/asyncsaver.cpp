@@ -0,0 +1,69 @@
+#include "../include/asyncsaver.hpp"
+#include "../include/planner.hpp"
+#include <chrono>
+
+namespace {
+    // Waits are timed and re-checked: the timed overloads are inline in the standard headers,
+    // so the binary still runs against older libstdc++ runtimes than the one it was built with
+    constexpr auto WaitSlice = std::chrono::milliseconds(200);
+}
+
+AsyncSaver::AsyncSaver() : writer(&AsyncSaver::run, this) {}
+
+AsyncSaver::~AsyncSaver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join(); // The writer drains the queue before exiting
+}
+
+void AsyncSaver::save(const std::string& filename, std::vector<AssignmentPtr> snapshot) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++counters.requested;
+        auto [slot, inserted] = pending.try_emplace(filename);
+        if (inserted)
+            order.push_back(filename);
+        else
+            ++counters.coalesced;
+        slot->second = std::move(snapshot);
+    }
+    wake.notify_one();
+}
+
+void AsyncSaver::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!drained.wait_for(lock, WaitSlice, [this] { return pending.empty() && !writing; })) {}
+}
+
+AsyncSaver::Stats AsyncSaver::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+void AsyncSaver::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        while (!wake.wait_for(lock, WaitSlice, [this] { return stopping || !pending.empty(); })) {}
+        if (pending.empty())
+            return; // Stopping with nothing left to write
+
+        // Take the oldest file; later requests for it queue up again behind this write
+        std::string filename = std::move(order.front());
+        order.pop_front();
+        auto node = pending.extract(filename);
+        writing = true;
+
+        lock.unlock();
+        Planner::saveToFile(filename, node.mapped());
+        node = {}; // Release the snapshot outside the lock
+        lock.lock();
+
+        writing = false;
+        ++counters.written;
+        if (pending.empty())
+            drained.notify_all();
+    }
+}
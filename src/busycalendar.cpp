@@ -0,0 +1,413 @@
+#include "../include/busycalendar.hpp"
+#include "../include/bitops.hpp"
+#include "../include/icsreader.hpp"
+#include "../include/mappedassignmentstore.hpp"
+#include "../include/studycalendar.hpp"
+#include "../include/timegrid.hpp"
+#include <algorithm>
+#include <ctime>
+
+namespace {
+    using IcsReader::equals;
+
+    constexpr long long MinutesPerDay = 24 * 60;
+
+    long long floorDiv(long long a, long long b) {
+        return a / b - ((a % b != 0 && (a < 0) != (b < 0)) ? 1 : 0);
+    }
+
+    // 0 = Sunday for a day number counted from 1970-01-01, a Thursday
+    int weekdayOf(long long days) {
+        return static_cast<int>(days - floorDiv(days + 4, 7) * 7 + 4);
+    }
+
+    bool parseDigits(std::string_view text, std::size_t offset, std::size_t count, int& value) {
+        if (offset + count > text.size())
+            return false;
+        value = 0;
+        for (std::size_t i = offset; i < offset + count; ++i) {
+            if (text[i] < '0' || text[i] > '9')
+                return false;
+            value = value * 10 + (text[i] - '0');
+        }
+        return true;
+    }
+
+    struct Moment {
+        long long minutes = 0; // Local minutes since 1970-01-01
+        bool dateOnly = false;
+    };
+
+    // How UTC times become local: a fixed offset, or the system time zone's offset at each instant
+    struct Zone {
+        bool system = false;
+        int fixedOffset = 0;
+
+        long long toLocal(long long utcMinutes) const {
+            return utcMinutes + (system ? BusyCalendar::localUtcOffsetMinutes(utcMinutes) : fixedOffset);
+        }
+    };
+
+    // YYYYMMDD or YYYYMMDDTHHMMSS[Z]. Times with a TZID are taken as floating local time.
+    bool parseMoment(std::string_view value, const Zone& zone, Moment& moment) {
+        CivilDate date;
+        if (!parseDigits(value, 0, 4, date.year) || !parseDigits(value, 4, 2, date.month) || !parseDigits(value, 6, 2, date.day))
+            return false;
+        if (date.month < 1 || date.month > 12 || date.day < 1 || date.day > 31)
+            return false;
+        moment.minutes = date.toDays() * MinutesPerDay;
+        moment.dateOnly = value.size() == 8;
+        if (moment.dateOnly)
+            return true;
+
+        int hour, minute, second;
+        if (value.size() < 15 || value[8] != 'T' || !parseDigits(value, 9, 2, hour) || !parseDigits(value, 11, 2, minute) ||
+            !parseDigits(value, 13, 2, second) || hour > 23 || minute > 59 || second > 60)
+            return false;
+        moment.minutes += hour * 60 + minute;
+        if (value.size() == 16 && value[15] == 'Z')
+            moment.minutes = zone.toLocal(moment.minutes);
+        else if (value.size() != 15)
+            return false;
+        return true;
+    }
+
+    // P[nW][nD][T[nH][nM][nS]], rounded up to whole minutes
+    bool parseDuration(std::string_view value, long long& minutes) {
+        std::size_t i = 0;
+        bool negative = false;
+        if (i < value.size() && (value[i] == '+' || value[i] == '-'))
+            negative = value[i++] == '-';
+        if (i >= value.size() || value[i++] != 'P')
+            return false;
+
+        long long seconds = 0;
+        bool time = false, any = false;
+        while (i < value.size()) {
+            if (value[i] == 'T') {
+                time = true;
+                ++i;
+                continue;
+            }
+            long long number = 0;
+            std::size_t digits = 0;
+            for (; i < value.size() && value[i] >= '0' && value[i] <= '9' && digits < 9; ++i, ++digits)
+                number = number * 10 + (value[i] - '0');
+            if (digits == 0 || i >= value.size())
+                return false;
+            switch (value[i++]) {
+            case 'W': seconds += number * 7 * 86400; break;
+            case 'D': seconds += number * 86400; break;
+            case 'H': if (!time) return false; seconds += number * 3600; break;
+            case 'M': if (!time) return false; seconds += number * 60; break;
+            case 'S': if (!time) return false; seconds += number; break;
+            default: return false;
+            }
+            any = true;
+        }
+        minutes = (seconds + 59) / 60;
+        if (negative)
+            minutes = -minutes;
+        return any;
+    }
+
+    // FREQ=DAILY|WEEKLY with INTERVAL, COUNT, UNTIL and BYDAY; false for anything else
+    bool parseRule(std::string_view rule, const Zone& zone, BusyEvent& event) {
+        static const char* const dayCodes[7] = {"SU", "MO", "TU", "WE", "TH", "FR", "SA"};
+
+        bool hasFrequency = false;
+        while (!rule.empty()) {
+            std::size_t end = rule.find(';');
+            std::string_view part = rule.substr(0, end);
+            rule = end == std::string_view::npos ? std::string_view() : rule.substr(end + 1);
+
+            std::size_t equalsSign = part.find('=');
+            if (equalsSign == std::string_view::npos)
+                return false;
+            std::string_view key = part.substr(0, equalsSign);
+            std::string_view value = part.substr(equalsSign + 1);
+
+            if (equals(key, "FREQ")) {
+                if (equals(value, "DAILY"))
+                    event.frequency = BusyEvent::Frequency::Daily;
+                else if (equals(value, "WEEKLY"))
+                    event.frequency = BusyEvent::Frequency::Weekly;
+                else
+                    return false;
+                hasFrequency = true;
+            } else if (equals(key, "INTERVAL") || equals(key, "COUNT")) {
+                int number;
+                if (value.empty() || value.size() > 6 || !parseDigits(value, 0, value.size(), number) || number < 1)
+                    return false;
+                if (equals(key, "INTERVAL"))
+                    event.interval = number;
+                else
+                    event.count = number;
+            } else if (equals(key, "UNTIL")) {
+                Moment until;
+                if (!parseMoment(value, zone, until))
+                    return false;
+                event.until = until.dateOnly ? until.minutes + MinutesPerDay - 1 : until.minutes;
+            } else if (equals(key, "BYDAY")) {
+                while (!value.empty()) {
+                    std::size_t comma = value.find(',');
+                    std::string_view code = value.substr(0, comma);
+                    value = comma == std::string_view::npos ? std::string_view() : value.substr(comma + 1);
+                    auto day = std::find_if(std::begin(dayCodes), std::end(dayCodes),
+                                            [code](const char* name) { return equals(code, name); });
+                    if (day == std::end(dayCodes))
+                        return false; // Includes ordinal days such as 1MO
+                    event.weekdays |= 1u << (day - std::begin(dayCodes));
+                }
+            } else if (!equals(key, "WKST")) {
+                return false; // BYMONTH, BYSETPOS and friends
+            }
+        }
+        return hasFrequency;
+    }
+
+    // Stand-in for a rule parseRule does not understand that covers all its occurrences: daily until
+    // its UNTIL, ignoring COUNT, which may span more than a day's worth of occurrences. Returns true
+    // when occurrences may start at any time of day (BYHOUR and friends, or a sub-daily FREQ), in
+    // which case whole days must be blocked.
+    bool conservativeRule(std::string_view rule, const Zone& zone, BusyEvent& event) {
+        event.frequency = BusyEvent::Frequency::Daily;
+        bool anyTime = false;
+        while (!rule.empty()) {
+            std::size_t end = rule.find(';');
+            std::string_view part = rule.substr(0, end);
+            rule = end == std::string_view::npos ? std::string_view() : rule.substr(end + 1);
+
+            std::size_t equalsSign = part.find('=');
+            std::string_view key = part.substr(0, equalsSign);
+            std::string_view value = equalsSign == std::string_view::npos ? std::string_view() : part.substr(equalsSign + 1);
+            Moment until;
+            if (equals(key, "UNTIL") && parseMoment(value, zone, until))
+                event.until = until.dateOnly ? until.minutes + MinutesPerDay - 1 : until.minutes;
+            else if (equals(key, "FREQ"))
+                anyTime |= !equals(value, "DAILY") && !equals(value, "WEEKLY") && !equals(value, "MONTHLY") && !equals(value, "YEARLY");
+            else if (equals(key, "BYHOUR") || equals(key, "BYMINUTE") || equals(key, "BYSECOND"))
+                anyTime = true;
+        }
+        return anyTime;
+    }
+
+    // Call `emit(start, end)` for each occurrence overlapping [from, to)
+    template <typename Emit>
+    void forEachOccurrence(const BusyEvent& event, long long from, long long to, Emit emit) {
+        if (event.frequency == BusyEvent::Frequency::Once) {
+            if (event.start < to && event.start + event.duration > from)
+                emit(event.start, event.start + event.duration);
+            return;
+        }
+
+        const long long startDay = floorDiv(event.start, MinutesPerDay);
+        const long long timeOfDay = event.start - startDay * MinutesPerDay;
+        // Earliest day an occurrence overlapping `from` can start on
+        const long long fromDay = floorDiv(from - event.duration, MinutesPerDay) - 1;
+        const bool counted = event.count >= 0;
+
+        // Returns false once the recurrence has ended or passed the range
+        auto occurrence = [&](long long day, long long index) {
+            const long long start = day * MinutesPerDay + timeOfDay;
+            if ((counted && index >= event.count) || start > event.until || start >= to)
+                return false;
+            if (start + event.duration > from)
+                emit(start, start + event.duration);
+            return true;
+        };
+
+        if (event.frequency == BusyEvent::Frequency::Daily && (event.weekdays == 0 || event.interval > 1)) {
+            // Skip straight to the range unless occurrences must be counted through a BYDAY filter
+            long long k = 0;
+            if (event.weekdays == 0 || !counted)
+                k = std::max(0LL, floorDiv(fromDay - startDay, event.interval));
+            long long index = k;
+            if (event.weekdays != 0)
+                index = 0;
+            for (;; ++k) {
+                const long long day = startDay + k * event.interval;
+                if (event.weekdays != 0 && !((event.weekdays >> weekdayOf(day)) & 1)) {
+                    if (day * MinutesPerDay >= to)
+                        return;
+                    continue;
+                }
+                if (!occurrence(day, index++))
+                    return;
+            }
+        }
+
+        // Weekly, or daily limited to some weekdays (the same thing): weeks start on Monday
+        const unsigned weekdays = event.weekdays != 0 ? event.weekdays : 1u << weekdayOf(startDay);
+        const long long weekStart = startDay - (weekdayOf(startDay) + 6) % 7;
+        const long long period = event.frequency == BusyEvent::Frequency::Daily ? 7 : 7LL * event.interval;
+        const int perPeriod = BitOps::popCount(weekdays);
+        int firstPeriod = 0;
+        for (int i = 0; i < 7; ++i)
+            if (((weekdays >> ((i + 1) % 7)) & 1) && weekStart + i >= startDay)
+                ++firstPeriod;
+
+        long long p = std::max(0LL, floorDiv(fromDay - weekStart, period));
+        long long index = p == 0 ? 0 : firstPeriod + (p - 1) * perPeriod;
+        for (;; ++p) {
+            for (int i = 0; i < 7; ++i) {
+                const long long day = weekStart + p * period + i;
+                if (!((weekdays >> ((i + 1) % 7)) & 1) || day < startDay)
+                    continue;
+                if (!occurrence(day, index++))
+                    return;
+            }
+        }
+    }
+
+    // Minutes since 1970-01-01 read off a broken-down time
+    long long wallClockMinutes(const std::tm& time) {
+        return CivilDate{time.tm_year + 1900, time.tm_mon + 1, time.tm_mday}.toDays() * MinutesPerDay + time.tm_hour * 60 + time.tm_min;
+    }
+}
+
+BusyCalendar BusyCalendar::parse(std::string_view text, int utcOffsetMinutes) {
+    return parse(text, false, utcOffsetMinutes);
+}
+
+BusyCalendar BusyCalendar::parse(std::string_view text) {
+    return parse(text, true, 0);
+}
+
+BusyCalendar BusyCalendar::parse(std::string_view text, bool systemZone, int utcOffsetMinutes) {
+    const Zone zone{systemZone, utcOffsetMinutes};
+    BusyCalendar calendar;
+    IcsReader::LineReader reader(text);
+    std::string_view line;
+
+    bool inEvent = false;
+    int nested = 0; // Components inside the current event, such as VALARM
+    BusyEvent event;
+    Moment start, end;
+    bool hasStart = false, hasEnd = false, hasDuration = false, malformed = false, notBusy = false;
+    bool wholeDays = false; // An unsupported rule whose occurrences may fall at any time of day
+
+    while (reader.next(line)) {
+        IcsReader::Property property;
+        if (!IcsReader::splitProperty(line, property))
+            continue;
+
+        if (equals(property.name, "BEGIN")) {
+            if (inEvent) {
+                ++nested;
+            } else if (equals(property.value, "VEVENT")) {
+                inEvent = true;
+                event = BusyEvent();
+                hasStart = hasEnd = hasDuration = malformed = notBusy = wholeDays = false;
+            }
+            continue;
+        }
+        if (!inEvent)
+            continue;
+
+        if (equals(property.name, "END")) {
+            if (nested > 0) {
+                --nested;
+                continue;
+            }
+            inEvent = false;
+            if (malformed || !hasStart) {
+                ++calendar.skippedEvents;
+                continue;
+            }
+            if (notBusy)
+                continue;
+
+            event.start = start.minutes;
+            if (hasEnd)
+                event.duration = end.minutes - start.minutes;
+            else if (!hasDuration)
+                event.duration = start.dateOnly ? MinutesPerDay : 0;
+            if (wholeDays && event.duration > 0) {
+                // Each day from midnight, plus the longest spill of an occurrence starting late that day
+                event.start = floorDiv(event.start, MinutesPerDay) * MinutesPerDay;
+                event.duration += MinutesPerDay;
+            }
+            if (event.duration > 0)
+                calendar.busyEvents.push_back(event);
+            continue;
+        }
+        if (nested > 0)
+            continue;
+
+        if (equals(property.name, "DTSTART")) {
+            hasStart = parseMoment(property.value, zone, start);
+            malformed |= !hasStart;
+        } else if (equals(property.name, "DTEND")) {
+            hasEnd = parseMoment(property.value, zone, end);
+            malformed |= !hasEnd;
+        } else if (equals(property.name, "DURATION")) {
+            hasDuration = parseDuration(property.value, event.duration);
+            malformed |= !hasDuration;
+        } else if (equals(property.name, "RRULE")) {
+            BusyEvent rule;
+            if (parseRule(property.value, zone, rule)) {
+                event.frequency = rule.frequency;
+                event.interval = rule.interval;
+                event.count = rule.count;
+                event.until = rule.until;
+                event.weekdays = rule.weekdays;
+            } else {
+                // Block more than the event may take rather than leave later occurrences free
+                ++calendar.ignoredRules;
+                BusyEvent fallback;
+                wholeDays = conservativeRule(property.value, zone, fallback);
+                event.frequency = fallback.frequency;
+                event.interval = fallback.interval;
+                event.count = fallback.count;
+                event.until = fallback.until;
+                event.weekdays = fallback.weekdays;
+            }
+        } else if (equals(property.name, "TRANSP")) {
+            notBusy |= equals(property.value, "TRANSPARENT");
+        } else if (equals(property.name, "STATUS")) {
+            notBusy |= equals(property.value, "CANCELLED");
+        }
+    }
+    return calendar;
+}
+
+BusyCalendar BusyCalendar::fromFile(const std::string& filename) {
+    MappedFile file(filename);
+    return parse(file.text());
+}
+
+int BusyCalendar::localUtcOffsetMinutes() {
+    return localUtcOffsetMinutes(static_cast<long long>(std::time(nullptr)) / 60);
+}
+
+int BusyCalendar::localUtcOffsetMinutes(long long utcMinutes) {
+    std::time_t instant = static_cast<std::time_t>(utcMinutes * 60);
+    std::tm local = *std::localtime(&instant);
+    std::tm utc = *std::gmtime(&instant);
+    return static_cast<int>(wallClockMinutes(local) - wallClockMinutes(utc));
+}
+
+void BusyCalendar::block(TimeGrid& grid, const CivilDate& base) const {
+    if (grid.days() <= 0)
+        return;
+    const long long slot = grid.slotMinutes();
+    const long long windowMinutes = grid.slotsPerDay() * slot;
+    const long long firstWindow = (base.toDays() + 1) * MinutesPerDay + grid.windowStart();
+    const long long horizonEnd = firstWindow + (grid.days() - 1) * MinutesPerDay + windowMinutes;
+
+    auto blockInterval = [&](long long from, long long to) {
+        for (long long day = std::max(0LL, floorDiv(from - firstWindow, MinutesPerDay)); day < grid.days(); ++day) {
+            const long long windowStart = firstWindow + day * MinutesPerDay;
+            if (windowStart >= to)
+                break;
+            const long long begin = std::max(from, windowStart) - windowStart;
+            const long long end = std::min(to, windowStart + windowMinutes) - windowStart;
+            if (end > begin)
+                grid.block(static_cast<int>(day) + 1, static_cast<int>(begin / slot), static_cast<int>((end + slot - 1) / slot - begin / slot));
+        }
+    };
+
+    for (const BusyEvent& event : busyEvents)
+        forEachOccurrence(event, firstWindow, horizonEnd, blockInterval);
+}
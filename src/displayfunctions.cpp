@@ -1,97 +1,205 @@
 #include "../include/displayfunctions.hpp"
+#include "../include/assignmentqueries.hpp"
+#include "../include/assignmentrenderer.hpp"
 #include <iostream>
 #include <algorithm>
 #include <limits>
 
+// Ask how many rows to show; 0 or invalid input shows everything
+static std::size_t readRowLimit() {
+    std::cout << "How many to show (0 for all): ";
+    long long count;
+    std::cin >> count;
+    if (std::cin.fail()) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        return DisplayFunctions::ShowAll;
+    }
+    return count > 0 ? static_cast<std::size_t>(count) : DisplayFunctions::ShowAll;
+}
+
+// Layout used by every display view
+static AssignmentRenderer::Layout currentLayout = AssignmentRenderer::Layout::Detailed;
+
+void DisplayFunctions::setLayout(AssignmentRenderer::Layout layout) { currentLayout = layout; }
+AssignmentRenderer::Layout DisplayFunctions::getLayout() { return currentLayout; }
+
+// Render assignments from `begin` until `end` or `limit` rows
+template <typename Iterator, typename Deref>
+static void renderRows(AssignmentRenderer& renderer, Iterator begin, Iterator end, std::size_t limit, Deref deref) {
+    for (std::size_t shown = 0; begin != end && shown < limit; ++begin, ++shown)
+        renderer.row(*deref(*begin));
+}
+
+// Dereference list entries and index entries
+static const DisplayFunctions::AssignmentPtr& fromList(const DisplayFunctions::AssignmentPtr& assignment) { return assignment; }
+template <typename Entry>
+static const DisplayFunctions::AssignmentPtr& fromIndex(const Entry& entry) { return entry.second; }
+
 // Display all assignments
 void DisplayFunctions::displayAllAssignments(const std::vector<AssignmentPtr>& assignments) {
+    AssignmentRenderer renderer(std::cout, currentLayout);
     if (assignments.empty()) {
-        std::cout << "No assignments to display.\n";
+        renderer.text("No assignments to display.\n");
         return;
     }
 
-    std::cout << "\nAll Assignments:\n";
-    for (const auto& assignment : assignments) {
-        assignment->display();
-        std::cout << "---------------------------\n";
-    }
+    renderer.text("\nAll Assignments:\n");
+    renderRows(renderer, assignments.begin(), assignments.end(), ShowAll, fromList);
 }
 
 // Display assignments filtered by subject
 void DisplayFunctions::displayAssignmentsBySubject(const std::vector<AssignmentPtr>& assignments, const std::string& subject) {
-    std::cout << "\nAssignments for Subject: " << subject << "\n";
+    AssignmentRenderer renderer(std::cout, currentLayout);
+    renderer.text("\nAssignments for Subject: " + subject + "\n");
     bool found = false;
+    SubjectId subjectId = SubjectTable::global().find(subject); // Unknown subjects match nothing
     for (const auto& assignment : assignments) {
-        if (assignment->getSubject() == subject) {
-            assignment->display();
-            std::cout << "---------------------------\n";
+        if (assignment->getSubjectId() == subjectId) {
+            renderer.row(*assignment);
             found = true;
         }
     }
 
     if (!found) {
-        std::cout << "No assignments found for subject: " << subject << "\n";
+        renderer.text("No assignments found for subject: " + subject + "\n");
     }
 }
 
 // Display assignments sorted by shortest deadline
-void DisplayFunctions::displayAssignmentsByShortestDeadline(const std::vector<AssignmentPtr>& assignments) {
+void DisplayFunctions::displayAssignmentsByShortestDeadline(const std::vector<AssignmentPtr>& assignments, std::size_t limit) {
+    AssignmentRenderer renderer(std::cout, currentLayout);
     if (assignments.empty()) {
-        std::cout << "No assignments to display.\n";
+        renderer.text("No assignments to display.\n");
         return;
     }
 
-    std::cout << "\nAssignments by Shortest Deadline:\n";
-    std::vector<AssignmentPtr> sortedAssignments(assignments);
+    renderer.text("\nAssignments by Shortest Deadline:\n");
+    auto sorted = AssignmentQueries::soonestDeadlines(assignments, limit);
+    renderRows(renderer, sorted.begin(), sorted.end(), ShowAll, fromList);
+}
+
+// Display assignments sorted by biggest duration
+void DisplayFunctions::displayAssignmentsByBiggestDuration(const std::vector<AssignmentPtr>& assignments, std::size_t limit) {
+    AssignmentRenderer renderer(std::cout, currentLayout);
+    if (assignments.empty()) {
+        renderer.text("No assignments to display.\n");
+        return;
+    }
 
-    std::sort(sortedAssignments.begin(), sortedAssignments.end(),
-              [](const AssignmentPtr& a, const AssignmentPtr& b) {
-                  return a->getDeadline() < b->getDeadline();
-              });
+    renderer.text("\nAssignments by Biggest Duration:\n");
+    auto sorted = AssignmentQueries::longestDurations(assignments, limit);
+    renderRows(renderer, sorted.begin(), sorted.end(), ShowAll, fromList);
+}
 
-    for (const auto& assignment : sortedAssignments) {
-        assignment->display();
-        std::cout << "---------------------------\n";
+// Display assignments due within the given number of days
+void DisplayFunctions::displayAssignmentsDueWithin(const std::vector<AssignmentPtr>& assignments, int days) {
+    AssignmentRenderer renderer(std::cout, currentLayout);
+    renderer.text("\nAssignments Due Within " + std::to_string(days) + " Days:\n");
+    auto dueSoon = AssignmentQueries::dueWithin(assignments, days);
+    if (dueSoon.empty()) {
+        renderer.text("No assignments due within " + std::to_string(days) + " days.\n");
+        return;
     }
+
+    renderRows(renderer, dueSoon.begin(), dueSoon.end(), ShowAll, fromList);
 }
 
-// Display assignments sorted by biggest duration
-void DisplayFunctions::displayAssignmentsByBiggestDuration(const std::vector<AssignmentPtr>& assignments) {
-    if (assignments.empty()) {
+// Display all assignments in store order
+void DisplayFunctions::displayAllAssignments(const AssignmentStore& store) {
+    displayAllAssignments(store.all());
+}
+
+// Display assignments filtered by subject using the subject index
+void DisplayFunctions::displayAssignmentsBySubject(const AssignmentStore& store, const std::string& subject) {
+    AssignmentRenderer renderer(std::cout, currentLayout);
+    renderer.text("\nAssignments for Subject: " + subject + "\n");
+    const auto& matches = store.bySubject(subject);
+    if (matches.empty()) {
+        renderer.text("No assignments found for subject: " + subject + "\n");
+        return;
+    }
+
+    renderRows(renderer, matches.begin(), matches.end(), ShowAll, fromList);
+}
+
+// Display assignment count and total hours per subject from the subject index
+void DisplayFunctions::displaySubjectSummary(const AssignmentStore& store) {
+    if (store.empty()) {
         std::cout << "No assignments to display.\n";
         return;
     }
 
-    std::cout << "\nAssignments by Biggest Duration:\n";
-    std::vector<AssignmentPtr> sortedAssignments(assignments);
+    std::vector<std::pair<const std::string*, const AssignmentStore::SubjectPosting*>> subjects;
+    for (const auto& entry : store.bySubjectId())
+        subjects.emplace_back(&SubjectTable::global().name(entry.first), &entry.second);
+    std::sort(subjects.begin(), subjects.end(), [](const auto& a, const auto& b) { return *a.first < *b.first; });
 
-    std::sort(sortedAssignments.begin(), sortedAssignments.end(),
-              [](const AssignmentPtr& a, const AssignmentPtr& b) {
-                  return a->getDuration() > b->getDuration();
-              });
+    std::cout << "\nSubject Summary:\n";
+    for (const auto& subject : subjects) {
+        std::cout << *subject.first << ": " << subject.second->assignments.size() << " assignment(s), "
+                  << subject.second->totalHours << " hours\n";
+    }
+}
 
-    for (const auto& assignment : sortedAssignments) {
-        assignment->display();
-        std::cout << "---------------------------\n";
+// Display assignments by shortest deadline using the deadline index
+void DisplayFunctions::displayAssignmentsByShortestDeadline(const AssignmentStore& store, std::size_t limit) {
+    AssignmentRenderer renderer(std::cout, currentLayout);
+    if (store.empty()) {
+        renderer.text("No assignments to display.\n");
+        return;
     }
+
+    renderer.text("\nAssignments by Shortest Deadline:\n");
+    const auto& index = store.byDeadline();
+    renderRows(renderer, index.begin(), index.end(), limit, fromIndex<AssignmentStore::DeadlineIndex::value_type>);
+}
+
+// Display assignments by biggest duration using the duration index
+void DisplayFunctions::displayAssignmentsByBiggestDuration(const AssignmentStore& store, std::size_t limit) {
+    AssignmentRenderer renderer(std::cout, currentLayout);
+    if (store.empty()) {
+        renderer.text("No assignments to display.\n");
+        return;
+    }
+
+    renderer.text("\nAssignments by Biggest Duration:\n");
+    const auto& index = store.byDuration();
+    renderRows(renderer, index.begin(), index.end(), limit, fromIndex<AssignmentStore::DurationIndex::value_type>);
+}
+
+// Display assignments due within the given number of days using the deadline index
+void DisplayFunctions::displayAssignmentsDueWithin(const AssignmentStore& store, int days) {
+    AssignmentRenderer renderer(std::cout, currentLayout);
+    renderer.text("\nAssignments Due Within " + std::to_string(days) + " Days:\n");
+    const auto& index = store.byDeadline();
+    auto end = index.upper_bound(AssignmentStore::IndexKey(days, std::numeric_limits<AssignmentId>::max()));
+    if (end == index.begin()) {
+        renderer.text("No assignments due within " + std::to_string(days) + " days.\n");
+        return;
+    }
+
+    renderRows(renderer, index.begin(), end, ShowAll, fromIndex<AssignmentStore::DeadlineIndex::value_type>);
 }
 
 // Display menu options for assignments
-void DisplayFunctions::displayMenu(const std::vector<AssignmentPtr>& assignments) {
+void DisplayFunctions::displayMenu(const AssignmentStore& assignments) {
     while (true) {
         std::cout << "\nDisplay Menu:\n"
                   << "1. Display all assignments\n"
                   << "2. Display assignments by subject\n"
                   << "3. Display assignments by shortest deadline\n"
                   << "4. Display assignments by biggest duration\n"
-                  << "5. Go back\n"
+                  << "5. Display assignments due within N days\n"
+                  << "6. Display subject summary\n"
+                  << "7. Go back\n"
                   << "Enter your choice: ";
 
         int choice;
         std::cin >> choice;
 
         // Input validation
-        if (std::cin.fail() || choice < 1 || choice > 5) {
+        if (std::cin.fail() || choice < 1 || choice > 7) {
             std::cin.clear();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
             std::cout << "Invalid choice. Please try again.\n";
@@ -110,12 +218,22 @@ void DisplayFunctions::displayMenu(const std::vector<AssignmentPtr>& assignments
                 break;
             }
             case 3:
-                displayAssignmentsByShortestDeadline(assignments);
+                displayAssignmentsByShortestDeadline(assignments, readRowLimit());
                 break;
             case 4:
-                displayAssignmentsByBiggestDuration(assignments);
+                displayAssignmentsByBiggestDuration(assignments, readRowLimit());
+                break;
+            case 5: {
+                std::cout << "Enter the number of days: ";
+                int days;
+                std::cin >> days;
+                displayAssignmentsDueWithin(assignments, days);
+                break;
+            }
+            case 6:
+                displaySubjectSummary(assignments);
                 break;
-            case 5:
+            case 7:
                 std::cout << "Exiting display menu.\n";
                 return;
         }
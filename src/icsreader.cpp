@@ -0,0 +1,67 @@
+#include "../include/icsreader.hpp"
+#include <algorithm>
+
+bool IcsReader::LineReader::next(std::string_view& line) {
+    if (position >= text.size())
+        return false;
+    line = physicalLine();
+    if (!continues())
+        return true;
+
+    unfolded.assign(line.data(), line.size());
+    while (continues())
+        unfolded.append(physicalLine().substr(1));
+    line = unfolded;
+    return true;
+}
+
+bool IcsReader::LineReader::continues() const {
+    return position < text.size() && (text[position] == ' ' || text[position] == '\t');
+}
+
+std::string_view IcsReader::LineReader::physicalLine() {
+    std::size_t end = text.find('\n', position);
+    if (end == std::string_view::npos)
+        end = text.size();
+    std::string_view line = text.substr(position, end - position);
+    position = std::min(end + 1, text.size());
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+    return line;
+}
+
+bool IcsReader::splitProperty(std::string_view line, Property& property) {
+    std::size_t i = 0;
+    while (i < line.size() && line[i] != ';' && line[i] != ':')
+        ++i;
+    if (i == line.size())
+        return false;
+    property.name = line.substr(0, i);
+
+    bool quoted = false;
+    std::size_t j = i;
+    for (; j < line.size(); ++j) {
+        if (line[j] == '"')
+            quoted = !quoted;
+        else if (line[j] == ':' && !quoted)
+            break;
+    }
+    if (j == line.size())
+        return false;
+    property.params = line.substr(i, j - i);
+    property.value = line.substr(j + 1);
+    return true;
+}
+
+bool IcsReader::equals(std::string_view text, std::string_view upper) {
+    if (text.size() != upper.size())
+        return false;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (c >= 'a' && c <= 'z')
+            c = static_cast<char>(c - 'a' + 'A');
+        if (c != upper[i])
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,274 @@
+#include "../include/icsschedule.hpp"
+#include "../include/icsreader.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <unordered_map>
+
+std::string IcsSchedule::formatDateTime(const CivilDate& date, long long minute) {
+    long long dayShift = minute >= 0 ? minute / 1440 : -((-minute + 1439) / 1440);
+    minute -= dayShift * 1440;
+    CivilDate day = date.plusDays(dayShift);
+    if (day.year < 0 || day.year > 9999)
+        throw std::out_of_range("ICS dates need a four-digit year: " + std::to_string(day.year));
+
+    // YYYYMMDDTHHMM00, written digit by digit now that every field fits its width
+    std::string text(15, '0');
+    auto put = [&text](std::size_t at, int value, int width) {
+        for (int i = width - 1; i >= 0; --i, value /= 10)
+            text[at + static_cast<std::size_t>(i)] = static_cast<char>('0' + value % 10);
+    };
+    put(0, day.year, 4);
+    put(4, day.month, 2);
+    put(6, day.day, 2);
+    text[8] = 'T';
+    put(9, static_cast<int>(minute / 60), 2);
+    put(11, static_cast<int>(minute % 60), 2);
+    return text;
+}
+
+namespace {
+    // FNV-1a over two texts with a separator between them
+    std::uint64_t hashPair(std::string_view first, std::string_view second) {
+        std::uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](std::string_view text) {
+            for (unsigned char c : text) {
+                hash ^= c;
+                hash *= 1099511628211ull;
+            }
+        };
+        mix(first);
+        mix(std::string_view("\n", 1));
+        mix(second);
+        return hash;
+    }
+}
+
+std::string IcsSchedule::formatStamp(const CivilDate& date) {
+    return formatDateTime(date, 0) + "Z";
+}
+
+std::string IcsSchedule::sessionUid(const Assignment& assignment, int session) {
+    char buffer[64];
+    if (assignment.getId() != 0) {
+        std::snprintf(buffer, sizeof(buffer), "a%llu-s%d@planner-app", static_cast<unsigned long long>(assignment.getId()), session);
+        return buffer;
+    }
+
+    std::uint64_t hash = hashPair(assignment.getSubject(), assignment.getName());
+    std::snprintf(buffer, sizeof(buffer), "h%016llx-s%d@planner-app", static_cast<unsigned long long>(hash), session);
+    return buffer;
+}
+
+std::string IcsSchedule::sessionUid(std::string_view start, std::string_view summary) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "-%016llx@planner-app", static_cast<unsigned long long>(hashPair(start, summary)));
+    return std::string(start) + buffer;
+}
+
+std::vector<IcsEvent> IcsSchedule::buildEvents(const std::vector<IcsSession>& sessions,
+                                               const std::vector<std::shared_ptr<Assignment>>& assignments,
+                                               const CivilDate& baseDate, bool compress) {
+    // Daily repeats of one block of an assignment, or a single session when not compressing
+    struct Series {
+        std::size_t assignment;
+        int startMinute;
+        int endMinute;
+        std::vector<int> days;
+    };
+    std::vector<Series> series;
+
+    if (!compress) {
+        for (const IcsSession& session : sessions)
+            series.push_back({session.assignment, session.startMinute, session.endMinute, {session.day}});
+    } else {
+        // Merge sessions continuing the assignment's previous block; sessions come in time order
+        std::vector<std::vector<IcsSession>> blocks(assignments.size());
+        for (const IcsSession& session : sessions) {
+            std::vector<IcsSession>& own = blocks[session.assignment];
+            if (!own.empty() && own.back().day == session.day && own.back().endMinute == session.startMinute)
+                own.back().endMinute = session.endMinute;
+            else
+                own.push_back(session);
+        }
+
+        // Extend the latest series with the same time window while the gap allows it
+        for (std::size_t assignment = 0; assignment < blocks.size(); ++assignment) {
+            const std::size_t first = series.size();
+            for (const IcsSession& block : blocks[assignment]) {
+                Series* open = nullptr;
+                for (std::size_t i = series.size(); i-- > first;) {
+                    if (series[i].startMinute == block.startMinute && series[i].endMinute == block.endMinute) {
+                        open = &series[i];
+                        break;
+                    }
+                }
+                if (open && block.day - open->days.back() - 1 <= MaxSeriesGapDays && block.day != open->days.back())
+                    open->days.push_back(block.day);
+                else
+                    series.push_back({assignment, block.startMinute, block.endMinute, {block.day}});
+            }
+        }
+        std::stable_sort(series.begin(), series.end(), [](const Series& a, const Series& b) {
+            return a.days.front() != b.days.front() ? a.days.front() < b.days.front() : a.startMinute < b.startMinute;
+        });
+    }
+
+    std::vector<IcsEvent> events;
+    events.reserve(series.size());
+    std::vector<int> ordinals(assignments.size(), 0);
+    for (const Series& entry : series) {
+        const Assignment& assignment = *assignments[entry.assignment];
+        const CivilDate date = baseDate.plusDays(entry.days.front());
+
+        IcsEvent event;
+        event.uid = sessionUid(assignment, ++ordinals[entry.assignment]);
+        event.summary = assignment.getName();
+        event.start = formatDateTime(date, entry.startMinute);
+        event.end = formatDateTime(date, entry.endMinute);
+        if (entry.days.size() > 1) {
+            const int span = entry.days.back() - entry.days.front() + 1;
+            event.rrule = "FREQ=DAILY;COUNT=" + std::to_string(span);
+            auto next = entry.days.begin();
+            for (int day = entry.days.front(); day <= entry.days.back(); ++day) {
+                if (*next == day)
+                    ++next;
+                else
+                    event.exdates.push_back(formatDateTime(baseDate.plusDays(day), entry.startMinute));
+            }
+        }
+        events.push_back(std::move(event));
+    }
+    return events;
+}
+
+void IcsSchedule::writeEvent(OutputBuffer& out, const IcsEvent& event, std::string_view stamp, bool cancelled) {
+    out.append("BEGIN:VEVENT\nUID:").append(event.uid).append('\n');
+    out.append("DTSTAMP:").append(stamp).append('\n');
+    out.append("SEQUENCE:").appendInt(event.sequence);
+    out.append("\nSUMMARY:").append(event.summary);
+    out.append("\nDTSTART:").append(event.start);
+    out.append("\nDTEND:").append(event.end).append('\n');
+    if (!event.rrule.empty())
+        out.append("RRULE:").append(event.rrule).append('\n');
+    for (const std::string& exdate : event.exdates)
+        out.append("EXDATE:").append(exdate).append('\n');
+    out.append("DESCRIPTION:Scheduled Assignment\n");
+    out.append(cancelled ? "STATUS:CANCELLED\n" : "STATUS:CONFIRMED\n");
+    out.append("END:VEVENT\n");
+}
+
+void IcsSchedule::writeEvent(std::ostream& out, const IcsEvent& event, std::string_view stamp, bool cancelled) {
+    OutputBuffer buffer(out);
+    writeEvent(buffer, event, stamp, cancelled);
+}
+
+void IcsSchedule::writeCalendar(OutputBuffer& out, const std::vector<IcsEvent>& events, const CivilDate& stampDate) {
+    const std::string stamp = formatStamp(stampDate);
+    out.append("BEGIN:VCALENDAR\nVERSION:2.0\nPRODID:-//Planner App//EN\n");
+    for (const IcsEvent& event : events) {
+        writeEvent(out, event, stamp);
+        out.flushIfFull();
+    }
+    out.append("END:VCALENDAR\n");
+}
+
+std::vector<IcsEvent> IcsSchedule::readEvents(std::string_view text) {
+    using IcsReader::equals;
+
+    std::vector<IcsEvent> events;
+    IcsReader::LineReader reader(text);
+    std::string_view line;
+    IcsEvent event;
+    bool inEvent = false;
+
+    while (reader.next(line)) {
+        IcsReader::Property property;
+        if (!IcsReader::splitProperty(line, property))
+            continue;
+
+        if (equals(property.name, "BEGIN") && equals(property.value, "VEVENT")) {
+            inEvent = true;
+            event = IcsEvent();
+        } else if (!inEvent) {
+            continue;
+        } else if (equals(property.name, "END") && equals(property.value, "VEVENT")) {
+            inEvent = false;
+            if (!event.uid.empty())
+                events.push_back(std::move(event));
+        } else if (equals(property.name, "UID")) {
+            event.uid.assign(property.value);
+        } else if (equals(property.name, "SUMMARY")) {
+            event.summary.assign(property.value);
+        } else if (equals(property.name, "DTSTART")) {
+            event.start.assign(property.value);
+        } else if (equals(property.name, "DTEND")) {
+            event.end.assign(property.value);
+        } else if (equals(property.name, "RRULE")) {
+            event.rrule.assign(property.value);
+        } else if (equals(property.name, "EXDATE")) {
+            event.exdates.emplace_back(property.value);
+        } else if (equals(property.name, "SEQUENCE")) {
+            int sequence = 0;
+            std::from_chars(property.value.data(), property.value.data() + property.value.size(), sequence);
+            event.sequence = sequence;
+        }
+    }
+    return events;
+}
+
+IcsSchedule::Delta IcsSchedule::diff(const std::vector<IcsEvent>& previous, std::vector<IcsEvent>& current) {
+    std::unordered_map<std::string_view, std::size_t> previousByUid;
+    previousByUid.reserve(previous.size());
+    for (std::size_t i = 0; i < previous.size(); ++i)
+        previousByUid.emplace(previous[i].uid, i);
+
+    Delta delta;
+    std::vector<char> kept(previous.size(), 0);
+    for (IcsEvent& event : current) {
+        auto match = previousByUid.find(event.uid);
+        if (match == previousByUid.end()) {
+            delta.published.push_back(event);
+            continue;
+        }
+
+        const IcsEvent& before = previous[match->second];
+        kept[match->second] = 1;
+        if (before.summary == event.summary && before.start == event.start && before.end == event.end &&
+            before.rrule == event.rrule && before.exdates == event.exdates) {
+            event.sequence = before.sequence;
+            ++delta.unchanged;
+        } else {
+            event.sequence = before.sequence + 1;
+            delta.published.push_back(event);
+        }
+    }
+
+    for (std::size_t i = 0; i < previous.size(); ++i) {
+        if (kept[i])
+            continue;
+        delta.cancelled.push_back(previous[i]);
+        delta.cancelled.back().sequence += 1;
+    }
+    return delta;
+}
+
+void IcsSchedule::writeDelta(std::ostream& out, const Delta& delta, const CivilDate& stampDate) {
+    const std::string stamp = formatStamp(stampDate);
+    OutputBuffer buffer(out);
+
+    auto calendar = [&buffer, &stamp](const std::vector<IcsEvent>& events, std::string_view method, bool cancelled) {
+        if (events.empty())
+            return;
+        buffer.append("BEGIN:VCALENDAR\nVERSION:2.0\nPRODID:-//Planner App//EN\nMETHOD:").append(method).append('\n');
+        for (const IcsEvent& event : events) {
+            writeEvent(buffer, event, stamp, cancelled);
+            buffer.flushIfFull();
+        }
+        buffer.append("END:VCALENDAR\n");
+    };
+    calendar(delta.published, "PUBLISH", false);
+    calendar(delta.cancelled, "CANCEL", true);
+}
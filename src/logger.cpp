@@ -0,0 +1,213 @@
+#include "../include/logger.hpp"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Timed waits only, as in AsyncSaver: they stay inline and run on older libstdc++ runtimes
+    constexpr auto WaitSlice = std::chrono::milliseconds(200);
+
+    std::atomic<int> threshold{static_cast<int>(LogLevel::Info)};
+    std::atomic<bool> dropWhenFull{false};
+
+    // Set once the backend is gone at exit; later records are written directly
+    std::atomic<bool> shutDown{false};
+
+    struct Record {
+        LogLevel level = LogLevel::Info;
+        std::string text;
+    };
+
+    void writeRecord(std::ostream& out, std::ostream& errors, const Record& record) {
+        if (record.level >= LogLevel::Error)
+            errors << "Error: " << record.text << '\n';
+        else if (record.level == LogLevel::Warn)
+            errors << "Warning: " << record.text << '\n';
+        else
+            out << record.text << '\n';
+    }
+
+    // Bounded ring of queued records drained by one writer thread
+    class Backend {
+    public:
+        Backend() : ring(Log::RingCapacity), writer(&Backend::run, this) {}
+
+        ~Backend() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_one();
+            writer.join(); // The writer drains the ring before exiting
+            shutDown = true;
+        }
+
+        void push(LogLevel level, std::string text) {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (count == ring.size()) {
+                if (level < LogLevel::Warn && dropWhenFull.load(std::memory_order_relaxed)) {
+                    ++droppedCount;
+                    return;
+                }
+                while (!space.wait_for(lock, WaitSlice, [this] { return count < ring.size(); })) {}
+            }
+            Record& slot = ring[(head + count) % ring.size()];
+            slot.level = level;
+            slot.text = std::move(text);
+            ++count;
+            lock.unlock();
+            wake.notify_one();
+        }
+
+        void flush() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!drained.wait_for(lock, WaitSlice, [this] { return count == 0 && !writing; })) {}
+        }
+
+        void setStreams(std::ostream& newOut, std::ostream& newErrors) {
+            flush();
+            std::lock_guard<std::mutex> lock(mutex);
+            out = &newOut;
+            errors = &newErrors;
+        }
+
+        std::size_t dropped() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return droppedCount;
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable wake;    // Signals the writer: records queued or stopping
+        std::condition_variable space;   // Signals blocked producers: the ring has room
+        std::condition_variable drained; // Signals flush(): ring empty and writer idle
+        std::vector<Record> ring;
+        std::size_t head = 0;
+        std::size_t count = 0;
+        std::size_t droppedCount = 0;
+        std::size_t droppedReported = 0;
+        bool writing = false;
+        bool stopping = false;
+        std::ostream* out = &std::cout;
+        std::ostream* errors = &std::cerr;
+        std::thread writer;
+
+        void run() {
+            std::vector<Record> batch;
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                while (!wake.wait_for(lock, WaitSlice, [this] { return stopping || count > 0; })) {}
+                if (count == 0)
+                    return; // Stopping with nothing left to write
+
+                // Take the whole ring at once, then write it outside the lock
+                batch.clear();
+                for (; count > 0; --count, head = (head + 1) % ring.size())
+                    batch.push_back(std::move(ring[head]));
+                std::size_t newlyDropped = droppedCount - droppedReported;
+                droppedReported = droppedCount;
+                std::ostream& batchOut = *out;
+                std::ostream& batchErrors = *errors;
+                writing = true;
+                lock.unlock();
+                space.notify_all();
+
+                for (const Record& record : batch)
+                    writeRecord(batchOut, batchErrors, record);
+                if (newlyDropped > 0)
+                    batchErrors << "Warning: " << newlyDropped << " log records dropped\n";
+                batchOut.flush();
+                batchErrors.flush();
+
+                lock.lock();
+                writing = false;
+                if (count == 0)
+                    drained.notify_all();
+            }
+        }
+    };
+
+    Backend& backend() {
+        static Backend instance;
+        return instance;
+    }
+}
+
+void Log::setLevel(LogLevel level) {
+    threshold.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void Log::setOverflow(Overflow policy) {
+    dropWhenFull.store(policy == Overflow::Drop, std::memory_order_relaxed);
+}
+
+LogLevel Log::level() {
+    return static_cast<LogLevel>(threshold.load(std::memory_order_relaxed));
+}
+
+bool Log::enabled(LogLevel level) {
+    return level != LogLevel::Off && static_cast<int>(level) >= threshold.load(std::memory_order_relaxed);
+}
+
+LogLevel Log::parseLevel(std::string_view name) {
+    if (name == "trace")
+        return LogLevel::Trace;
+    if (name == "debug")
+        return LogLevel::Debug;
+    if (name == "info")
+        return LogLevel::Info;
+    if (name == "warn")
+        return LogLevel::Warn;
+    if (name == "error")
+        return LogLevel::Error;
+    if (name == "off")
+        return LogLevel::Off;
+    throw std::invalid_argument("Unknown log level: " + std::string(name));
+}
+
+void Log::write(LogLevel level, std::string text) {
+    if (shutDown) {
+        writeRecord(std::cout, std::cerr, Record{level, std::move(text)});
+        return;
+    }
+    backend().push(level, std::move(text));
+}
+
+void Log::flush() {
+    if (!shutDown)
+        backend().flush();
+}
+
+void Log::setStreams(std::ostream& out, std::ostream& errors) {
+    if (!shutDown)
+        backend().setStreams(out, errors);
+}
+
+std::size_t Log::dropped() {
+    return shutDown ? 0 : backend().dropped();
+}
+
+Log::Line& Log::Line::operator<<(double value) {
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+    text.append(digits, result.ptr);
+    return *this;
+}
+
+void Log::Line::appendSigned(long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    text.append(digits, result.ptr);
+}
+
+void Log::Line::appendUnsigned(unsigned long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    text.append(digits, result.ptr);
+}
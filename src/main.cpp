@@ -1,11 +1,24 @@
 #include "FileException.hpp"
 #include "../include/planner.hpp"
 #include "../include/displayfunctions.hpp"
+#include "../include/ndjsonimport.hpp"
+#include "../include/assignmentstore.hpp"
+#include "../include/asyncsaver.hpp"
+#include "../include/plannerdaemon.hpp"
+#include "../include/priorityrules.hpp"
+#include "../include/logger.hpp"
+#include "../include/arena.hpp"
+#include <csignal>
+#include <cstdlib>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 #include <filesystem>
 #include <fstream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
 
 // Ensure the Data directory exists
 void ensureDataDirectoryExists() {
@@ -24,8 +37,139 @@ void checkUserFile(const std::string& filename) {
     }
 }
 
-int main() {
+// Print all assignments of a user in the selected layout, for piping into other tools
+int listAssignments(const std::string& name) {
+    std::string userFile = "Data/" + name + ".json";
+    checkUserFile(userFile);
+    DisplayFunctions::displayAllAssignments(Planner::loadFromFile(userFile));
+    return 0;
+}
+
+// Import a multi-user NDJSON dump into the users' files
+int importNdjson(const std::string& filename) {
+    ensureDataDirectoryExists();
+    auto result = NdjsonImport::importFile(filename);
+    std::cout << "Imported " << result.assignments << " assignments for " << result.users.size() << " users";
+    if (!result.badLines.empty())
+        std::cout << " (" << result.badLines.size() << " lines skipped)";
+    std::cout << "\n";
+    return result.badLines.empty() && result.rejectedUsers.empty() && result.unreadableUsers.empty() ? 0 : 3;
+}
+
+// Daemon being served, so termination signals can stop it cleanly
+static PlannerDaemon* activeDaemon = nullptr;
+
+void stopDaemon(int) {
+    if (activeDaemon)
+        activeDaemon->stop();
+}
+
+// Serve JSON-RPC requests on a Unix domain socket until shut down
+int runDaemon(const std::string& socketPath, std::size_t cacheBudget) {
+    ensureDataDirectoryExists();
+
+    // Request handling never waits on a slow log reader
+    Log::setOverflow(Log::Overflow::Drop);
+
+    PlannerDaemon daemon(cacheBudget);
+    activeDaemon = &daemon;
+    std::signal(SIGINT, stopDaemon);
+    std::signal(SIGTERM, stopDaemon);
+
+    std::cout << "Serving on " << socketPath << "\n";
+    daemon.serve(socketPath);
+    activeDaemon = nullptr;
+    return 0;
+}
+
+// Print command line usage
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--layout=detailed|table|tsv|ndjson] [--rules <file>] [--base-date <YYYY-MM-DD>] [--ics-delta] [--ics-expanded] [--export csv|ndjson|binary]... [--quiet | --log-level trace|debug|info|warn|error|off] [--list <name> | --import-ndjson <file> | --daemon <socket> [--cache-mb <n>]]\n";
+}
+
+int main(int argc, char* argv[]) {
+    // Command line options
+    std::string listUser;
+    std::string daemonSocket;
+    std::string importPath;
+    std::size_t cacheBudget = UserStoreCache::DefaultByteBudget;
+    std::optional<CivilDate> baseDate; // Fixed date for reproducible schedules
+    Planner::IcsOptions icsOptions;
+    std::vector<ScheduleExport::Format> exports; // Extra schedule formats written next to the ICS file
+    std::optional<LogLevel> logLevel;            // Interactive sessions default to debug, batch runs to info
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--layout=", 0) == 0) {
+            try {
+                DisplayFunctions::setLayout(AssignmentRenderer::parseLayout(arg.substr(std::string("--layout=").size())));
+            } catch (const std::invalid_argument& e) {
+                std::cerr << e.what() << "\n";
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--rules" && i + 1 < argc) {
+            try {
+                PriorityRules::setActive(PriorityRules::fromFile(argv[++i]));
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << "\n";
+                return 1;
+            }
+        } else if (arg == "--base-date" && i + 1 < argc) {
+            try {
+                baseDate = CivilDate::parse(argv[++i]);
+            } catch (const std::invalid_argument& e) {
+                std::cerr << e.what() << "\n";
+                return 1;
+            }
+        } else if (arg == "--ics-delta") {
+            icsOptions.writeDelta = true; // Also write the changes since the previous schedule
+        } else if (arg == "--ics-expanded") {
+            icsOptions.compressRecurring = false; // One event per study session, for clients without RRULE support
+        } else if (arg == "--export" && i + 1 < argc) {
+            try {
+                exports.push_back(ScheduleExport::parseFileFormat(argv[++i]));
+            } catch (const std::invalid_argument& e) {
+                std::cerr << e.what() << "\n";
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--quiet") {
+            logLevel = LogLevel::Warn; // Only warnings and errors, no schedule trace
+        } else if (arg == "--log-level" && i + 1 < argc) {
+            try {
+                logLevel = Log::parseLevel(argv[++i]);
+            } catch (const std::invalid_argument& e) {
+                std::cerr << e.what() << "\n";
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--list" && i + 1 < argc) {
+            listUser = argv[++i];
+        } else if (arg == "--import-ndjson" && i + 1 < argc) {
+            importPath = argv[++i];
+        } else if (arg == "--daemon" && i + 1 < argc) {
+            daemonSocket = argv[++i];
+        } else if (arg == "--cache-mb" && i + 1 < argc) {
+            cacheBudget = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10)) * 1024 * 1024;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    Log::setLevel(logLevel.value_or(LogLevel::Info));
+
     try {
+        if (!listUser.empty())
+            return listAssignments(listUser);
+        if (!importPath.empty())
+            return importNdjson(importPath);
+        if (!daemonSocket.empty())
+            return runDaemon(daemonSocket, cacheBudget);
+
+        // The interactive scheduler lists every study hour unless asked to be quiet
+        Log::setLevel(logLevel.value_or(LogLevel::Debug));
+
         // Step 1: Ensure the Data directory exists
         try {
             ensureDataDirectoryExists();
@@ -59,17 +203,23 @@ int main() {
         }
 
         // Step 4: Load assignments
-        std::vector<Planner::AssignmentPtr> assignments;
+        AssignmentStore assignments;
         try {
-            assignments = Planner::loadFromFile(userFile);
+            auto loaded = Planner::loadFromFile(userFile);
+            AssignmentArena::moveToHeap(loaded); // The session edits the store; don't pin the load arena
+            assignments = AssignmentStore(std::move(loaded));
         } catch (const std::exception& e) {
             std::cerr << "Error while loading assignments: " << e.what() << "\n";
             return 2; // Exit if assignments cannot be loaded
         }
 
+        // Saves run in the background; whatever is still queued is written before main returns
+        AsyncSaver saver;
+
         // Step 5: Main menu loop
         while (true) {
             try {
+                Log::flush(); // Keep queued messages ahead of the menu
                 std::cout << "\nMain Menu:\n";
                 std::cout << "1. Add an Assignment\n";
                 std::cout << "2. Delete an Assignment\n";
@@ -123,10 +273,10 @@ int main() {
 
                         auto newAssignment = std::make_shared<Assignment>(
                             subject, name, deadline, duration, weight, size, groupWork, groupSize);
-                        assignments.push_back(newAssignment);
+                        assignments.add(newAssignment);
 
                         // Save changes to the file
-                        Planner::saveToFile(userFile, assignments);
+                        saver.save(userFile, assignments.all());
                         std::cout << "Assignment added successfully.\n";
                         break;
                     }
@@ -138,21 +288,21 @@ int main() {
                         }
 
                         std::cout << "Select the assignment to delete:\n";
-                        for (size_t i = 0; i < assignments.size(); ++i) {
-                            std::cout << i + 1 << ". " << assignments[i]->getName() << "\n";
+                        for (const auto& assignment : assignments.all()) {
+                            std::cout << "[" << assignment->getId() << "] " << assignment->getName() << "\n";
                         }
-                        std::cout << "Enter your choice: ";
-
-                        size_t deleteIndex;
-                        std::cin >> deleteIndex;
+                        std::cout << "Enter the assignment id: ";
 
-                        if (deleteIndex > 0 && deleteIndex <= assignments.size()) {
-                            assignments.erase(assignments.begin() + (deleteIndex - 1));
+                        AssignmentId deleteId;
+                        std::cin >> deleteId;
 
+                        if (!std::cin.fail() && assignments.remove(deleteId)) {
                             // Save changes to the file
-                            Planner::saveToFile(userFile, assignments);
+                            saver.save(userFile, assignments.all());
                             std::cout << "Assignment deleted successfully.\n";
                         } else {
+                            std::cin.clear();
+                            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
                             std::cout << "Invalid choice.\n";
                         }
                         break;
@@ -164,14 +314,49 @@ int main() {
                             break;
                         }
 
-                        int weekdayHours, weekendHours;
-                        std::cout << "Enter weekday study hours: ";
-                        std::cin >> weekdayHours;
-                        std::cout << "Enter weekend study hours: ";
-                        std::cin >> weekendHours;
+                        // A study calendar with holidays and exception days replaces the hour prompts
+                        StudyCalendar calendar;
+                        std::string calendarFile = "Data/" + name + "_calendar.json";
+                        std::string busyFile = "Data/" + name + "_busy.ics";
+                        try {
+                            if (std::filesystem::exists(calendarFile)) {
+                                calendar = StudyCalendar::fromFile(calendarFile);
+                                std::cout << "Using study calendar " << calendarFile << "\n";
+                            } else {
+                                int weekdayHours, weekendHours;
+                                std::cout << "Enter weekday study hours: ";
+                                std::cin >> weekdayHours;
+                                std::cout << "Enter weekend study hours: ";
+                                std::cin >> weekendHours;
+                                calendar = StudyCalendar(weekdayHours, weekendHours);
+                            }
 
-                        Planner::scheduler(assignments, weekdayHours, weekendHours, name);
+                            // Existing appointments block study time
+                            if (std::filesystem::exists(busyFile)) {
+                                BusyCalendar busy = BusyCalendar::fromFile(busyFile);
+                                std::cout << "Avoiding " << busy.events().size() << " busy events from " << busyFile << "\n";
+                                if (busy.unsupportedRules() > 0)
+                                    std::cerr << "Warning: " << busy.unsupportedRules() << " recurrence rules in " << busyFile
+                                              << " are not supported; their events are blocked every day instead.\n";
+                                calendar.setBusyTimes(std::move(busy));
+                            }
+                        } catch (const std::exception& e) {
+                            std::cerr << "Error: " << e.what() << "\n";
+                            break;
+                        }
+
+                        const CivilDate scheduleDate = baseDate.value_or(CivilDate::today());
+                        Planner::scheduler(assignments.all(), calendar, name, scheduleDate, icsOptions);
+                        Log::flush();
                         std::cout << "\nSchedule saved to Data/" << name << "_schedule.ics\n";
+                        for (ScheduleExport::Format format : exports) {
+                            try {
+                                std::cout << "Schedule exported to "
+                                          << Planner::exportSchedule(assignments.all(), calendar, name, scheduleDate, format) << "\n";
+                            } catch (const FileException& e) {
+                                std::cerr << "Error: " << e.what() << "\n";
+                            }
+                        }
                         break;
                     }
                     case 4: {
@@ -184,7 +369,8 @@ int main() {
                         std::cout << "Goodbye!\\n";
 
                         // Save changes before exiting
-                        Planner::saveToFile(userFile, assignments);
+                        saver.save(userFile, assignments.all());
+                        saver.flush();
                         return 0;
                     }
                 }
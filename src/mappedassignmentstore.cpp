@@ -0,0 +1,165 @@
+#include "../include/mappedassignmentstore.hpp"
+#include "../include/assignmentparser.hpp"
+#include "../include/json.hpp"
+#include "FileException.hpp"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+MappedFile::MappedFile(const std::string& filename) {
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw FileException("Could not open file " + filename + ": " + std::strerror(errno));
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw FileException("Could not stat file " + filename + ": " + std::strerror(errno));
+    }
+
+    length = static_cast<std::size_t>(info.st_size);
+    if (length > 0) {
+        void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            throw FileException("Could not map file " + filename + ": " + std::strerror(errno));
+        }
+        ::madvise(address, length, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(address);
+        mapped = true;
+    }
+    ::close(fd); // The mapping keeps the file contents reachable
+#else
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        throw FileException("Could not open file " + filename);
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = buffer.data();
+    length = buffer.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data(std::exchange(other.data, nullptr)), length(std::exchange(other.length, 0)),
+      mapped(std::exchange(other.mapped, false)), buffer(std::move(other.buffer)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data = std::exchange(other.data, nullptr);
+        length = std::exchange(other.length, 0);
+        mapped = std::exchange(other.mapped, false);
+        buffer = std::move(other.buffer);
+    }
+    return *this;
+}
+
+std::string_view MappedFile::text() const {
+    return std::string_view(data, length);
+}
+
+void MappedFile::release() {
+#ifndef _WIN32
+    if (mapped)
+        ::munmap(const_cast<char*>(data), length);
+#endif
+    data = nullptr;
+    length = 0;
+    mapped = false;
+    buffer.clear();
+}
+
+MappedAssignmentStore::MappedAssignmentStore(const std::string& filename) : file(filename) {
+    bool parsed = AssignmentParser::parseArray(file.text(), [this](const AssignmentParser::Record& record) {
+        AssignmentView view;
+        view.id = record.id;
+        view.subject = record.subjectEscaped ? keep(record.subject) : record.subject;
+        view.name = record.nameEscaped ? keep(record.name) : record.name;
+        view.deadline = record.deadline;
+        view.duration = record.duration;
+        view.weight = record.weight;
+        view.size = record.size;
+        view.groupWork = record.groupWork;
+        view.groupSize = record.groupSize;
+        assignments.push_back(view);
+    });
+
+    if (!parsed) {
+        assignments.clear();
+        decoded.clear();
+        loadWithJson(filename);
+    }
+
+    // Views are scheduled as stored, so out-of-range fields (a group_size of 0 divides by zero) stop here
+    for (std::size_t i = 0; i < assignments.size(); ++i) {
+        const AssignmentView& view = assignments[i];
+        if (!Assignment::validFields(view.deadline, view.duration, view.size, view.groupSize))
+            throw FileException("Invalid fields in assignment " + std::to_string(i + 1) + " of " + filename);
+    }
+}
+
+// Files outside the fast parser's shape are read with nlohmann, copying their strings
+void MappedAssignmentStore::loadWithJson(const std::string& filename) {
+    try {
+        json jsonData = json::parse(file.text());
+        for (const auto& obj : jsonData) {
+            AssignmentView view;
+            view.id = obj.value("id", AssignmentId(0));
+            view.subject = keep(obj.at("subject").get<std::string>());
+            view.name = keep(obj.at("name").get<std::string>());
+            view.deadline = obj.at("deadline").get<int>();
+            view.duration = obj.at("duration").get<int>();
+            view.weight = obj.at("weight").get<float>();
+            view.size = obj.at("size").get<int>();
+            view.groupWork = obj.at("group_work").get<bool>();
+            view.groupSize = obj.at("group_size").get<int>();
+            assignments.push_back(view);
+        }
+    } catch (const json::exception& e) {
+        throw FileException("Failed to parse " + filename + " - " + e.what());
+    }
+}
+
+std::string_view MappedAssignmentStore::keep(std::string_view text) {
+    decoded.emplace_back(text);
+    return decoded.back();
+}
+
+const std::vector<AssignmentView>& MappedAssignmentStore::all() const {
+    return assignments;
+}
+
+const AssignmentView& MappedAssignmentStore::at(std::size_t index) const {
+    if (index >= assignments.size())
+        throw std::out_of_range("Assignment index out of range: " + std::to_string(index));
+    return assignments[index];
+}
+
+std::size_t MappedAssignmentStore::size() const {
+    return assignments.size();
+}
+
+bool MappedAssignmentStore::empty() const {
+    return assignments.empty();
+}
+
+std::size_t MappedAssignmentStore::decodedStrings() const {
+    return decoded.size();
+}
@@ -0,0 +1,178 @@
+#include "../include/ndjsonimport.hpp"
+#include "../include/arena.hpp"
+#include "../include/assignmentparser.hpp"
+#include "../include/assignmentstore.hpp"
+#include "../include/json.hpp"
+#include "../include/logger.hpp"
+#include "../include/planner.hpp"
+#include "FileException.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+using json = nlohmann::json;
+
+namespace {
+    // Chunks smaller than this are not worth a thread of their own
+    constexpr std::size_t MinChunkBytes = 256 * 1024;
+
+    // Assignments of one chunk, in line order
+    struct ChunkResult {
+        std::vector<std::pair<std::string, NdjsonImport::AssignmentPtr>> assignments;
+        std::vector<std::size_t> badLines; // Relative to the chunk's first line
+        std::size_t lines = 0;
+    };
+
+    // Lines the fast parser rejects go through nlohmann, as loadFromFile does
+    bool parseWithJson(std::string_view line, AssignmentArena& arena, ChunkResult& result) {
+        try {
+            json obj = json::parse(line);
+            int deadline = obj.at("deadline").get<int>();
+            int duration = obj.at("duration").get<int>();
+            int size = obj.at("size").get<int>();
+            int groupSize = obj.at("group_size").get<int>();
+            if (!Assignment::validFields(deadline, duration, size, groupSize))
+                return false;
+
+            auto assignment = arena.make(
+                obj.at("subject").get<std::string>(),
+                obj.at("name").get<std::string>(),
+                deadline,
+                duration,
+                obj.at("weight").get<float>(),
+                size,
+                obj.at("group_work").get<bool>(),
+                groupSize
+            );
+            assignment->setId(obj.value("id", AssignmentId(0)));
+            result.assignments.emplace_back(obj.at("user").get<std::string>(), std::move(assignment));
+            return true;
+        } catch (const json::exception&) {
+            return false;
+        }
+    }
+
+    void parseChunk(std::string_view chunk, ChunkResult& result) {
+        // One arena per chunk, so worker threads never share an allocator
+        AssignmentArena arena(AssignmentArena::initialBytesForFile(chunk.size()));
+        std::size_t start = 0;
+        while (start < chunk.size()) {
+            std::size_t end = chunk.find('\n', start);
+            if (end == std::string_view::npos)
+                end = chunk.size();
+            std::string_view line = chunk.substr(start, end - start);
+            start = end + 1;
+
+            std::size_t lineIndex = result.lines++;
+            if (line.find_first_not_of(" \t\r") == std::string_view::npos)
+                continue; // Blank lines are allowed
+
+            // A well-formed line with out-of-range fields is bad too; it would reach the Assignment otherwise
+            bool valid = true;
+            bool parsed = AssignmentParser::parseLine(line, [&](const AssignmentParser::Record& record) {
+                valid = Assignment::validFields(record.deadline, record.duration, record.size, record.groupSize);
+                if (!valid)
+                    return;
+                auto assignment = arena.make(
+                    std::string(record.subject), std::string(record.name), record.deadline, record.duration,
+                    record.weight, record.size, record.groupWork, record.groupSize);
+                assignment->setId(record.id);
+                result.assignments.emplace_back(std::string(record.user), std::move(assignment));
+            });
+            if (parsed ? !valid : !parseWithJson(line, arena, result))
+                result.badLines.push_back(lineIndex);
+        }
+    }
+
+    // Split `text` into about `count` chunks, each ending just after a newline (or at the end)
+    std::vector<std::string_view> splitChunks(std::string_view text, std::size_t count) {
+        std::vector<std::string_view> chunks;
+        std::size_t target = std::max<std::size_t>(1, text.size() / count);
+        std::size_t start = 0;
+        while (start < text.size()) {
+            std::size_t end = std::min(text.size(), start + target);
+            if (end < text.size()) {
+                end = text.find('\n', end);
+                end = end == std::string_view::npos ? text.size() : end + 1;
+            }
+            chunks.push_back(text.substr(start, end - start));
+            start = end;
+        }
+        return chunks;
+    }
+}
+
+NdjsonImport::Result NdjsonImport::parse(std::string_view text, unsigned threads) {
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t chunkCount = std::min<std::size_t>(threads, std::max<std::size_t>(1, text.size() / MinChunkBytes));
+
+    std::vector<std::string_view> chunks = splitChunks(text, chunkCount);
+    std::vector<ChunkResult> results(chunks.size());
+
+    // The calling thread takes the first chunk
+    std::vector<std::thread> workers;
+    workers.reserve(chunks.size());
+    for (std::size_t i = 1; i < chunks.size(); ++i)
+        workers.emplace_back(parseChunk, chunks[i], std::ref(results[i]));
+    if (!chunks.empty())
+        parseChunk(chunks[0], results[0]);
+    for (auto& worker : workers)
+        worker.join();
+
+    // Merge in chunk order so each user's assignments keep their file order
+    Result merged;
+    std::size_t firstLine = 1;
+    for (auto& chunk : results) {
+        for (auto& entry : chunk.assignments)
+            merged.users[entry.first].push_back(std::move(entry.second));
+        merged.assignments += chunk.assignments.size();
+        for (std::size_t line : chunk.badLines)
+            merged.badLines.push_back(firstLine + line);
+        firstLine += chunk.lines;
+    }
+    return merged;
+}
+
+NdjsonImport::Result NdjsonImport::importFile(const std::string& filename, const std::string& dataDirectory,
+                                              unsigned threads) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        throw FileException("Could not open import file " + filename);
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    Result result = parse(text, threads);
+    for (std::size_t line : result.badLines)
+        LOG_ERROR("Could not parse line " << line << " of " << filename << ", skipped.");
+
+    for (const auto& [user, assignments] : result.users) {
+        if (!Planner::isValidUserName(user)) {
+            LOG_ERROR("Invalid user name " << user << " in " << filename << ", "
+                      << assignments.size() << " assignments skipped.");
+            result.rejectedUsers.push_back(user);
+            continue;
+        }
+
+        std::string userFile = dataDirectory + "/" + user + ".json";
+
+        // A file that exists but cannot be loaded is left alone rather than replaced by the import alone
+        AssignmentStore store;
+        if (std::filesystem::exists(userFile)) {
+            try {
+                store = AssignmentStore(Planner::loadExistingFile(userFile));
+            } catch (const FileException& e) {
+                LOG_ERROR(e.what() << ", " << assignments.size() << " assignments for " << user << " skipped.");
+                result.unreadableUsers.push_back(user);
+                continue;
+            }
+        }
+        for (const auto& assignment : assignments)
+            store.add(assignment);
+
+        Planner::saveToFile(userFile, store.all());
+    }
+    return result;
+}
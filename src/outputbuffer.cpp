@@ -0,0 +1,102 @@
+#include "../include/outputbuffer.hpp"
+#include <charconv>
+
+OutputBuffer::OutputBuffer(std::ostream& out, std::size_t flushThreshold)
+    : out(out), flushThreshold(flushThreshold) {}
+
+OutputBuffer::~OutputBuffer() {
+    flush();
+}
+
+OutputBuffer& OutputBuffer::append(std::string_view text) {
+    buffer.append(text.data(), text.size());
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::append(char c) {
+    buffer.push_back(c);
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::appendInt(long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::appendUnsigned(unsigned long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::appendFloat(float value) {
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+    buffer.append(digits, result.ptr);
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::appendShortestFloat(float value) {
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::appendJsonString(std::string_view text) {
+    static const char hex[] = "0123456789abcdef";
+
+    buffer.push_back('"');
+    std::size_t plain = 0; // Start of the pending run of characters needing no escape
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        buffer.append(text.data() + plain, i - plain);
+        plain = i + 1;
+        switch (c) {
+            case '"': buffer.append("\\\""); break;
+            case '\\': buffer.append("\\\\"); break;
+            case '\n': buffer.append("\\n"); break;
+            case '\r': buffer.append("\\r"); break;
+            case '\t': buffer.append("\\t"); break;
+            case '\b': buffer.append("\\b"); break;
+            case '\f': buffer.append("\\f"); break;
+            default:
+                buffer.append("\\u00");
+                buffer.push_back(hex[c >> 4]);
+                buffer.push_back(hex[c & 0xF]);
+        }
+    }
+    buffer.append(text.data() + plain, text.size() - plain);
+    buffer.push_back('"');
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::appendPadded(std::string_view text, std::size_t width) {
+    if (text.size() >= width) {
+        buffer.append(text.data(), width);
+    } else {
+        buffer.append(text.data(), text.size());
+        buffer.append(width - text.size(), ' ');
+    }
+    return *this;
+}
+
+void OutputBuffer::flush() {
+    if (buffer.empty())
+        return;
+
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+    buffer.clear();
+}
+
+void OutputBuffer::flushIfFull() {
+    if (buffer.size() >= flushThreshold)
+        flush();
+}
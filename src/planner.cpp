@@ -1,36 +1,54 @@
 #include "../include/planner.hpp"
 #include "../include/json.hpp"
+#include "../include/arena.hpp"
+#include "../include/icsschedule.hpp"
+#include "../include/logger.hpp"
+#include "../include/assignmentparser.hpp"
+#include "../include/outputbuffer.hpp"
+#include "../include/priorityrules.hpp"
+#include "../include/scheduleengine.hpp"
+#include "../include/schedulesink.hpp"
+#include "FileException.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <iostream>
 #include <fstream>
-#include <queue>
-#include <algorithm>
 #include <iterator>
 #include <iomanip>
-#include <ctime>
 #include <sstream>
+#include <stdexcept>
 
 // Use the nlohmann JSON namespace
 using json = nlohmann::json;
 
-// Implementation of loadFromFile
-std::vector<Planner::AssignmentPtr> Planner::loadFromFile(const std::string& filename) {
-    std::vector<AssignmentPtr> assignments;
+namespace {
+    // Parse an assignment file into `assignments`; throws json::exception when it is not valid
+    void parseAssignmentFile(const std::string& text, std::vector<Planner::AssignmentPtr>& assignments) {
+        // The loaded assignments share one arena, released when the last of them is
+        AssignmentArena arena(AssignmentArena::initialBytesForFile(text.size()));
+
+        // Fast path for files in the exact shape saveToFile writes
+        bool parsed = AssignmentParser::parseArray(text, [&](const AssignmentParser::Record& record) {
+            auto assignment = arena.make(
+                std::string(record.subject), std::string(record.name), record.deadline, record.duration,
+                record.weight, record.size, record.groupWork, record.groupSize);
+            assignment->setId(record.id);
+            assignments.push_back(assignment);
+        });
+        if (parsed)
+            return;
 
-    // Open the file
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << filename << " for reading.\n";
-        return assignments; // Return an empty vector
-    }
+        // Anything else (hand-edited files, unexpected fields, errors) goes through the general parser
+        assignments.clear();
+        arena = AssignmentArena(AssignmentArena::initialBytesForFile(text.size()));
 
-    try {
         // Parse the JSON file
-        json jsonData;
-        file >> jsonData;
+        json jsonData = json::parse(text);
 
         // Convert JSON objects to Assignment instances
         for (const auto& obj : jsonData) {
-            auto assignment = std::make_shared<Assignment>(
+            auto assignment = arena.make(
                 obj.at("subject").get<std::string>(),
                 obj.at("name").get<std::string>(),
                 obj.at("deadline").get<int>(),
@@ -40,201 +58,273 @@ std::vector<Planner::AssignmentPtr> Planner::loadFromFile(const std::string& fil
                 obj.at("group_work").get<bool>(),
                 obj.at("group_size").get<int>()
             );
+            assignment->setId(obj.value("id", AssignmentId(0)));
 
             assignments.push_back(assignment);
         }
+    }
+
+    std::string readWholeFile(std::ifstream& file) {
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+}
+
+// Implementation of loadFromFile
+std::vector<Planner::AssignmentPtr> Planner::loadFromFile(const std::string& filename) {
+    std::vector<AssignmentPtr> assignments;
+
+    // Open the file
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("Could not open file " << filename << " for reading.");
+        return assignments; // Return an empty vector
+    }
+
+    try {
+        parseAssignmentFile(readWholeFile(file), assignments);
     } catch (const json::exception& e) {
-        std::cerr << "Error: Failed to parse JSON - " << e.what() << "\n";
+        LOG_ERROR("Failed to parse JSON - " << e.what());
     }
 
     return assignments;
 }
 
+std::vector<Planner::AssignmentPtr> Planner::loadExistingFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        throw FileException("Could not open file " + filename + " for reading.");
+
+    std::vector<AssignmentPtr> assignments;
+    try {
+        parseAssignmentFile(readWholeFile(file), assignments);
+    } catch (const json::exception& e) {
+        throw FileException("Could not parse " + filename + " - " + e.what());
+    }
+    return assignments;
+}
+
+bool Planner::isValidUserName(const std::string& name) {
+    if (name.empty() || name.size() > 128 || name[0] == '.')
+        return false;
+    for (char c : name) {
+        bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                       c == '_' || c == '-' || c == '.';
+        if (!allowed)
+            return false;
+    }
+    return true;
+}
+
 void Planner::addToICSFile(const std::string& icsFilePath, const std::string& assignmentName, int dayOffset, int hour) {
+    addToICSFile(icsFilePath, assignmentName, CivilDate::today().plusDays(dayOffset), (18 + hour) * 60, 60); // 6 PM + scheduled hour
+}
+
+void Planner::addToICSFile(const std::string& icsFilePath, const std::string& assignmentName, const CivilDate& date, int startMinute, int minutes) {
     std::ofstream icsFile(icsFilePath, std::ios::app);
 
     if (!icsFile.is_open()) {
-        std::cerr << "Error: Could not open ICS file for writing.\n";
+        LOG_ERROR("Could not open ICS file for writing.");
         return;
     }
 
-    // Get the current date
-    std::time_t now = std::time(nullptr);
-    std::tm* timeInfo = std::localtime(&now);
-
-    // Add the day offset and set the event start and end times
-    timeInfo->tm_mday += dayOffset;
-    timeInfo->tm_hour = 18 + hour;  // Start time: 6 PM + scheduled hour
-    timeInfo->tm_min = 0;
-    timeInfo->tm_sec = 0;
-    std::time_t startTime = std::mktime(timeInfo);
-
-    timeInfo->tm_hour += 1;  // End time: 1 hour after start
-    std::time_t endTime = std::mktime(timeInfo);
-
-    // Convert start and end times to the required format
-    char startBuffer[16], endBuffer[16];
-    std::strftime(startBuffer, sizeof(startBuffer), "%Y%m%dT%H%M%S", std::localtime(&startTime));
-    std::strftime(endBuffer, sizeof(endBuffer), "%Y%m%dT%H%M%S", std::localtime(&endTime));
+    IcsEvent event;
+    event.start = IcsSchedule::formatDateTime(date, startMinute);
+    event.end = IcsSchedule::formatDateTime(date, static_cast<long long>(startMinute) + minutes);
+    event.uid = IcsSchedule::sessionUid(event.start, assignmentName); // Sessions at the same time still differ
+    event.summary = assignmentName;
+    IcsSchedule::writeEvent(icsFile, event, IcsSchedule::formatStamp(CivilDate::today()));
+}
 
-    // Write the event details to the ICS file
-    icsFile << "BEGIN:VEVENT\n";
-    icsFile << "SUMMARY:" << assignmentName << "\n";
-    icsFile << "DTSTART:" << startBuffer << "\n";
-    icsFile << "DTEND:" << endBuffer << "\n";
-    icsFile << "DESCRIPTION:Scheduled Assignment\n";
-    icsFile << "STATUS:CONFIRMED\n";
-    icsFile << "END:VEVENT\n";
+namespace {
+    // JSON number for a weight; integral values keep a ".0" so they read back as floats
+    void appendJsonFloat(OutputBuffer& out, float value) {
+        if (!std::isfinite(value)) {
+            out.append("null"); // JSON has no NaN or infinity
+            return;
+        }
+        char digits[32];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        std::string_view text(digits, static_cast<std::size_t>(result.ptr - digits));
+        out.append(text);
+        if (text.find_first_of(".e") == std::string_view::npos)
+            out.append(".0");
+    }
 
-    icsFile.close();
+    // One assignment object, keys in the sorted order nlohmann::json used to write
+    void appendAssignmentJson(OutputBuffer& out, const Assignment& assignment, bool pretty) {
+        const std::string_view open = pretty ? "    {\n        " : "{";
+        const std::string_view separator = pretty ? ",\n        " : ",";
+        const std::string_view colon = pretty ? ": " : ":";
+
+        out.append(open);
+        out.append("\"deadline\"").append(colon).appendInt(assignment.getDeadline()).append(separator);
+        out.append("\"duration\"").append(colon).appendInt(assignment.getDuration()).append(separator);
+        out.append("\"group_size\"").append(colon).appendInt(assignment.getGroupSize()).append(separator);
+        out.append("\"group_work\"").append(colon).append(assignment.isGroupWork() ? "true" : "false").append(separator);
+        if (assignment.getId() != 0)
+            out.append("\"id\"").append(colon).appendUnsigned(assignment.getId()).append(separator);
+        out.append("\"name\"").append(colon).appendJsonString(assignment.getName()).append(separator);
+        out.append("\"size\"").append(colon).appendInt(assignment.getSize()).append(separator);
+        out.append("\"subject\"").append(colon).appendJsonString(assignment.getSubject()).append(separator);
+        out.append("\"weight\"").append(colon);
+        appendJsonFloat(out, assignment.getWeight());
+        out.append(pretty ? "\n    }" : "}");
+    }
 }
 
-void Planner::saveToFile(const std::string& filename, const std::vector<AssignmentPtr>& assignments) {
+bool Planner::saveToFile(const std::string& filename, const std::vector<AssignmentPtr>& assignments, JsonStyle style) {
     std::ofstream file(filename, std::ios::trunc); // Open file in truncate mode to overwrite existing data
     if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << filename << " for writing.\n";
-        return;
+        LOG_ERROR("Could not open file " << filename << " for writing.");
+        return false;
     }
 
-    nlohmann::json jsonData;
-
-    // Serialize each assignment into JSON format
-    for (const auto& assignment : assignments) {
-        jsonData.push_back({
-            {"subject", assignment->getSubject()},
-            {"name", assignment->getName()},
-            {"deadline", assignment->getDeadline()},
-            {"duration", assignment->getDuration()},
-            {"weight", assignment->getWeight()},
-            {"size", assignment->getSize()},
-            {"group_work", assignment->isGroupWork()},
-            {"group_size", assignment->getGroupSize()}
-        });
+    // Stream each assignment straight into the buffer; nothing proportional to the file is built
+    const bool pretty = style == JsonStyle::Pretty;
+    OutputBuffer out(file);
+    out.append('[');
+    for (std::size_t i = 0; i < assignments.size(); ++i) {
+        if (i > 0)
+            out.append(',');
+        if (pretty)
+            out.append('\n');
+        appendAssignmentJson(out, *assignments[i], pretty);
+        out.flushIfFull();
     }
-
-    // Write JSON data to file
-    file << jsonData.dump(4); // Pretty print with 4-space indentation
-    file.close();
+    if (pretty && !assignments.empty())
+        out.append('\n');
+    out.append(']');
+    out.flush();
+
+    file.flush();
+    if (!file) {
+        LOG_ERROR("Failed to write file " << filename << ".");
+        return false;
+    }
+    return true;
 }
 
 
 // Helper function to calculate priority
 int Planner::calculatePriority(const Assignment& assignment, int studyHoursPerDay) {
-    int remainingHours = assignment.getDeadline() * studyHoursPerDay;
-    int priority = 0;
-
-    // Add priority based on deadline
-    if (assignment.getDeadline() < 2)
-        priority += 10;
-    else if (assignment.getDeadline() < 4)
-        priority += 8;
-    else if (assignment.getDeadline() < 6)
-        priority += 6;
-    else if (assignment.getDeadline() < 8)
-        priority += 4;
-
-    // Add priority based on remaining time
-    if ((remainingHours - assignment.getRealDuration()) < 2)
-        priority += 20;
-    else if ((remainingHours - assignment.getRealDuration()) < 4)
-        priority += 15;
-    else if ((remainingHours - assignment.getRealDuration()) < 6)
-        priority += 10;
-
-    // Add priority based on weight
-    if (assignment.getWeight() > 20)
-        priority += 6;
-    else if (assignment.getWeight() > 15)
-        priority += 4;
-    else if (assignment.getWeight() > 10)
-        priority += 2;
-
-    // Add priority based on size
-    if (assignment.getSize() == 1)
-        priority += 3;
-    else if (assignment.getSize() == 2)
-        priority += 2;
-    else if (assignment.getSize() == 3)
-        priority += 1;
-
-    return priority;
-}
-
-// Scheduler implementation using a priority queue
-void Planner::scheduler(const std::vector<AssignmentPtr>& assignments, int weekdayStudyHours, int weekendStudyHours, const std::string& userName) {
-    // Define the ICS file path based on the user name
-    std::string icsFilePath = "Data/" + userName + "_schedule.ics";
+    return calculatePriority(assignment.getDeadline(), assignment.getRealDuration(), assignment.getWeight(),
+                             assignment.getSize(), studyHoursPerDay);
+}
 
-    // Ensure the ICS file starts with a proper calendar header
-    std::ofstream icsFile(icsFilePath, std::ios::trunc);
-    if (icsFile.is_open()) {
-        icsFile << "BEGIN:VCALENDAR\n";
-        icsFile << "VERSION:2.0\n";
-        icsFile << "PRODID:-//Planner App//EN\n";
-        icsFile.close();
-    } else {
-        std::cerr << "Error: Could not create ICS file.\n";
-        return;
-    }
+int Planner::calculatePriority(int deadline, int realDuration, float weight, int size, int studyHoursPerDay) {
+    return PriorityRules::active().score(deadline, realDuration, weight, size, studyHoursPerDay);
+}
 
-    std::vector<AssignmentPtr> assignmentList(assignments);
-    int day = 1;
+// Scheduler implementation: the engine plans every hour, then the plan is printed and exported
+void Planner::scheduler(const std::vector<AssignmentPtr>& assignments, int weekdayStudyHours, int weekendStudyHours, const std::string& userName) {
+    scheduler(assignments, StudyCalendar(weekdayStudyHours, weekendStudyHours), userName);
+}
 
-    while (!assignmentList.empty()) {
-        std::cout << "\nDay " << day << ":\n";
-        int studyHours = (day % 6 == 0 || day % 7 == 0) ? weekendStudyHours : weekdayStudyHours;
-        auto compare = [](const AssignmentPtr& a, const AssignmentPtr& b) {
-            return a->getPriority() < b->getPriority();
-        };
-        std::priority_queue<AssignmentPtr, std::vector<AssignmentPtr>, decltype(compare)> priorityQueue(compare);
+void Planner::scheduler(const std::vector<AssignmentPtr>& assignments, const StudyCalendar& calendar, const std::string& userName) {
+    scheduler(assignments, calendar, userName, CivilDate::today());
+}
 
-        for (const auto& assignment : assignmentList) {
-            int priority = calculatePriority(*assignment, studyHours);
-            assignment->setPriority(priority);
-            priorityQueue.push(assignment);
+namespace {
+    // Trace of the schedule as it is emitted: days and hours at debug level, missed deadlines at info
+    class LogTraceSink : public ScheduleSink {
+    public:
+        void begin(const Assignments& assignments, const CivilDate&) override {
+            this->assignments = &assignments;
         }
 
-        for (int i = 0; i < studyHours; ++i) {
-            if (priorityQueue.empty())
-                break;
+        void day(int day) override {
+            LOG_DEBUG("\nDay " << day << ":");
+            lastHour = -1;
+        }
 
-            auto currentAssignment = priorityQueue.top();
-            priorityQueue.pop();
+        // An hour split around busy times arrives as several sessions but is listed once
+        void session(const ScheduledSession& session) override {
+            if (session.hour == lastHour)
+                return;
+            lastHour = session.hour;
+            LOG_DEBUG("Hour " << (session.hour + 1) << ": " << (*assignments)[session.assignment]->getName());
+        }
 
-            std::cout << "Hour " << (i + 1) << ": " << currentAssignment->getName() << "\n";
-            currentAssignment->decreaseDuration(1);
+        void missed(const MissedDeadline& missed) override {
+            LOG_INFO("Missed deadline for assignment: " << (*assignments)[missed.assignment]->getName());
+        }
 
-            // Add the scheduled assignment to the ICS file
-            addToICSFile(icsFilePath, currentAssignment->getName(), day, i);
+    private:
+        const Assignments* assignments = nullptr;
+        int lastHour = -1;
+    };
+}
 
-            if (currentAssignment->getRealDuration() <= 0) {
-                auto it = std::find(assignmentList.begin(), assignmentList.end(), currentAssignment);
-                if (it != assignmentList.end())
-                    assignmentList.erase(it);
-            } else {
-                currentAssignment->setPriority(calculatePriority(*currentAssignment, studyHours));
-                priorityQueue.push(currentAssignment);
-            }
+void Planner::emitSchedule(const std::vector<AssignmentPtr>& assignments, const StudyCalendar& calendar,
+                           const CivilDate& baseDate, ScheduleSink& sink) {
+    // Capacity for the whole horizon, built once from real dates and limited to the free study window
+    const int horizon = scheduleHorizon(assignments);
+    TimeGrid grid = calendar.timeGrid(baseDate, horizon);
+    DayCapacity capacity = calendar.freeCapacity(baseDate, horizon, grid);
+    ScheduleResult schedule = computeSchedule(assignments, capacity);
+
+    sink.begin(assignments, baseDate);
+    auto slot = schedule.slots.begin();
+    auto missed = schedule.missed.begin();
+    for (int day = 1; day <= schedule.days; ++day) {
+        sink.day(day);
+
+        for (; slot != schedule.slots.end() && slot->day == day; ++slot) {
+            // Place the hour in the earliest free slots of the window
+            for (const SlotRun& run : grid.take(day, grid.slotsPerHour()))
+                sink.session({slot->assignment, day, slot->hour, grid.minuteOf(run.firstSlot), grid.minuteOf(run.firstSlot + run.length)});
         }
 
-        for (auto it = assignmentList.begin(); it != assignmentList.end();) {
-            (*it)->decreaseDeadline(1);
-            if ((*it)->getDeadline() <= 0) {
-                std::cout << "Missed deadline for assignment: " << (*it)->getName() << "\n";
-                it = assignmentList.erase(it);
-            } else {
-                ++it;
-            }
-        }
+        for (; missed != schedule.missed.end() && missed->day == day; ++missed)
+            sink.missed({missed->assignment, day});
+    }
+    sink.finish();
+}
+
+void Planner::scheduler(const std::vector<AssignmentPtr>& assignments, const StudyCalendar& calendar, const std::string& userName,
+                        const CivilDate& baseDate, const IcsOptions& options) {
+    // Define the ICS file path based on the user name
+    std::string icsFilePath = "Data/" + userName + "_schedule.ics";
+
+    // Compare with the previous output, carrying its sequence numbers over
+    std::ifstream previousFile(icsFilePath);
+    std::string previous((std::istreambuf_iterator<char>(previousFile)), std::istreambuf_iterator<char>());
+    previousFile.close();
 
-        ++day;
+    std::ofstream icsFile(icsFilePath, std::ios::trunc);
+    if (!icsFile.is_open()) {
+        LOG_ERROR("Could not create ICS file.");
+        return;
+    }
+    IcsScheduleSink ics(icsFile, options.compressRecurring, IcsSchedule::readEvents(previous));
+    if (Log::enabled(LogLevel::Info)) {
+        LogTraceSink trace;
+        TeeScheduleSink sink({&trace, &ics});
+        emitSchedule(assignments, calendar, baseDate, sink);
+    } else {
+        emitSchedule(assignments, calendar, baseDate, ics);
     }
 
-    // Add the ICS footer
-    icsFile.open(icsFilePath, std::ios::app);
-    if (icsFile.is_open()) {
-        icsFile << "END:VCALENDAR\n";
-        icsFile.close();
+    // Only what changed since the previous run, for calendar clients that sync incrementally
+    if (options.writeDelta) {
+        std::ofstream deltaFile("Data/" + userName + "_schedule_delta.ics", std::ios::trunc);
+        if (!deltaFile.is_open()) {
+            LOG_ERROR("Could not create ICS delta file.");
+            return;
+        }
+        IcsSchedule::writeDelta(deltaFile, ics.delta(), baseDate);
     }
 }
 
+std::string Planner::exportSchedule(const std::vector<AssignmentPtr>& assignments, const StudyCalendar& calendar,
+                                    const std::string& userName, const CivilDate& baseDate, ScheduleExport::Format format) {
+    if (format == ScheduleExport::Format::Ics || format == ScheduleExport::Format::Null)
+        throw std::invalid_argument("exportSchedule writes csv, ndjson or binary; the ICS schedule comes from Planner::scheduler");
+    std::string path = "Data/" + userName + "_schedule." + ScheduleExport::extension(format);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        throw FileException("Could not create schedule export " + path);
+    std::unique_ptr<ScheduleSink> sink = ScheduleExport::makeSink(format, file);
+    emitSchedule(assignments, calendar, baseDate, *sink);
+    return path;
+}
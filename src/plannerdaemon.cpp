@@ -0,0 +1,353 @@
+#include "../include/plannerdaemon.hpp"
+#include "../include/planner.hpp"
+#include "../include/scheduleengine.hpp"
+#include "../include/json.hpp"
+#include "FileException.hpp"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+namespace {
+    // JSON-RPC 2.0 error codes
+    constexpr int ParseError = -32700;
+    constexpr int InvalidRequest = -32600;
+    constexpr int MethodNotFound = -32601;
+    constexpr int InvalidParams = -32602;
+    constexpr int ServerError = -32000;
+
+    // Largest accepted assignment fields
+    constexpr int MaxDurationHours = StudyCalendar::MaxHorizonDays * 24;
+    constexpr int MaxSize = 1000;
+    constexpr int MaxGroupSize = 1000;
+
+    // Longest request line accepted from a client, and the unsent responses at which it is no longer read
+    constexpr std::size_t MaxRequestBytes = 1024 * 1024;
+    constexpr std::size_t MaxPendingOutput = 4 * 1024 * 1024;
+
+    // Error reported back to the client instead of a result
+    struct RpcError {
+        int code;
+        std::string message;
+    };
+
+    json assignmentToJson(const Assignment& assignment) {
+        return {
+            {"id", assignment.getId()},
+            {"subject", assignment.getSubject()},
+            {"name", assignment.getName()},
+            {"deadline", assignment.getDeadline()},
+            {"duration", assignment.getDuration()},
+            {"weight", assignment.getWeight()},
+            {"size", assignment.getSize()},
+            {"group_work", assignment.isGroupWork()},
+            {"group_size", assignment.getGroupSize()}
+        };
+    }
+
+    // Build an assignment from request params; fields missing from params are taken from `base`, or required without one
+    std::shared_ptr<Assignment> assignmentFromParams(const json& params, const Assignment* base) {
+        auto optional = [&](const char* key, auto fallback) {
+            return params.contains(key) ? params.at(key).get<decltype(fallback)>() : fallback;
+        };
+        auto field = [&](const char* key, auto fallback) {
+            return base ? optional(key, fallback) : params.at(key).get<decltype(fallback)>();
+        };
+
+        // Out-of-range numbers are rejected before they reach the Assignment, which divides by group_size
+        auto bounded = [](const char* key, int value, int minimum, int maximum) {
+            if (value < minimum || value > maximum)
+                throw RpcError{InvalidParams, std::string("Invalid params: ") + key + " must be between " +
+                                              std::to_string(minimum) + " and " + std::to_string(maximum)};
+            return value;
+        };
+
+        int groupSize = bounded("group_size", optional("group_size", base ? base->getGroupSize() : 1), 1, MaxGroupSize);
+        bool groupWork = optional("group_work", base ? base->isGroupWork() : groupSize > 1);
+        int deadline = bounded("deadline", field("deadline", base ? base->getDeadline() : 0), 0, StudyCalendar::MaxHorizonDays);
+        int duration = bounded("duration", field("duration", base ? base->getDuration() : 0), 0, MaxDurationHours);
+        int size = bounded("size", field("size", base ? base->getSize() : 0), 0, MaxSize);
+
+        return std::make_shared<Assignment>(
+            field("subject", base ? base->getSubject() : std::string()),
+            field("name", base ? base->getName() : std::string()),
+            deadline,
+            duration,
+            field("weight", base ? base->getWeight() : 0.0f),
+            size,
+            groupWork,
+            groupSize);
+    }
+
+    // Optional params.base_date (YYYY-MM-DD) pins day 1 of a schedule to the day after it
+    CivilDate baseDateFromParams(const json& params) {
+        if (!params.contains("base_date"))
+            return CivilDate::today();
+        try {
+            return CivilDate::parse(params.at("base_date").get<std::string>());
+        } catch (const std::invalid_argument& e) {
+            throw RpcError{InvalidParams, e.what()};
+        }
+    }
+
+    std::string errorResponse(const json& id, int code, const std::string& message) {
+        return json{{"jsonrpc", "2.0"}, {"id", id}, {"error", {{"code", code}, {"message", message}}}}.dump();
+    }
+}
+
+PlannerDaemon::PlannerDaemon(std::size_t cacheBudget)
+    : stores(cacheBudget) {}
+
+std::string PlannerDaemon::handleRequest(const std::string& line) {
+    json request;
+    try {
+        request = json::parse(line);
+    } catch (const json::exception& e) {
+        return errorResponse(nullptr, ParseError, std::string("Parse error: ") + e.what());
+    }
+
+    json id = request.is_object() && request.contains("id") ? request["id"] : json(nullptr);
+    try {
+        if (!request.is_object() || !request.contains("method") || !request["method"].is_string())
+            throw RpcError{InvalidRequest, "Invalid request"};
+
+        const std::string method = request["method"].get<std::string>();
+        const json params = request.value("params", json::object());
+        json result;
+
+        if (method == "shutdown") {
+            stop();
+            result = "ok";
+        } else if (method == "stats") {
+            const UserStoreCache::Stats& stats = stores.stats();
+            result = {{"users", stores.size()}, {"bytes", stores.bytesUsed()}, {"budget", stores.byteBudget()},
+                      {"hits", stats.hits}, {"misses", stats.misses}, {"evictions", stats.evictions}, {"saves", stats.saves},
+                      {"failed_saves", stats.failedSaves}};
+        } else {
+            if (!params.is_object() || !params.contains("user") || !params["user"].is_string())
+                throw RpcError{InvalidParams, "Missing params.user"};
+            const std::string user = params["user"].get<std::string>();
+            if (!Planner::isValidUserName(user))
+                throw RpcError{InvalidParams, "Invalid user name: " + user};
+
+            try {
+                if (method == "add") {
+                    AssignmentStore& store = stores.get(user);
+                    AssignmentId id = store.add(assignmentFromParams(params, nullptr));
+                    stores.markDirty(user);
+                    result = {{"id", id}};
+                } else if (method == "update") {
+                    AssignmentStore& store = stores.get(user);
+                    AssignmentId id = params.at("id").get<AssignmentId>();
+                    auto current = store.find(id);
+                    if (!current)
+                        throw RpcError{InvalidParams, "No assignment with id " + std::to_string(id)};
+                    store.update(id, assignmentFromParams(params, current.get()));
+                    stores.markDirty(user);
+                    result = {{"updated", id}};
+                } else if (method == "delete") {
+                    AssignmentStore& store = stores.get(user);
+                    AssignmentId id = params.at("id").get<AssignmentId>();
+                    if (!store.remove(id))
+                        throw RpcError{InvalidParams, "No assignment with id " + std::to_string(id)};
+                    stores.markDirty(user);
+                    result = {{"deleted", id}};
+                } else if (method == "list") {
+                    result = json::array();
+                    for (const auto& assignment : stores.get(user).all())
+                        result.push_back(assignmentToJson(*assignment));
+                } else if (method == "schedule") {
+                    const auto& assignments = stores.get(user).all();
+                    // Same real-calendar days and study-window limits as export_ics
+                    StudyCalendar calendar(params.at("weekday_hours").get<int>(), params.at("weekend_hours").get<int>());
+                    Planner::ScheduleResult schedule = Planner::computeSchedule(
+                        assignments, calendar.freeCapacity(baseDateFromParams(params), Planner::scheduleHorizon(assignments)));
+
+                    json slots = json::array();
+                    for (const auto& slot : schedule.slots)
+                        slots.push_back({{"day", slot.day}, {"hour", slot.hour}, {"name", assignments[slot.assignment]->getName()}});
+                    json missed = json::array();
+                    for (const auto& entry : schedule.missed)
+                        missed.push_back({{"day", entry.day}, {"name", assignments[entry.assignment]->getName()}});
+                    result = {{"days", schedule.days}, {"slots", slots}, {"missed", missed}};
+                } else if (method == "export_ics") {
+                    StudyCalendar calendar(params.at("weekday_hours").get<int>(), params.at("weekend_hours").get<int>());
+                    Planner::IcsOptions options;
+                    options.writeDelta = params.value("delta", false);
+                    options.compressRecurring = params.value("compress", true);
+                    Planner::scheduler(stores.get(user).all(), calendar, user, baseDateFromParams(params), options);
+                    result = {{"path", "Data/" + user + "_schedule.ics"}};
+                    if (options.writeDelta)
+                        result["delta_path"] = "Data/" + user + "_schedule_delta.ics";
+                } else if (method == "export_schedule") {
+                    StudyCalendar calendar(params.at("weekday_hours").get<int>(), params.at("weekend_hours").get<int>());
+                    ScheduleExport::Format format;
+                    try {
+                        format = ScheduleExport::parseFileFormat(params.at("format").get<std::string>());
+                    } catch (const std::invalid_argument& e) {
+                        throw RpcError{InvalidParams, e.what()};
+                    }
+                    result = {{"path", Planner::exportSchedule(stores.get(user).all(), calendar, user, baseDateFromParams(params), format)}};
+                } else {
+                    throw RpcError{MethodNotFound, "Method not found: " + method};
+                }
+            } catch (const json::exception& e) {
+                throw RpcError{InvalidParams, std::string("Invalid params: ") + e.what()};
+            }
+        }
+
+        return json{{"jsonrpc", "2.0"}, {"id", id}, {"result", result}}.dump();
+    } catch (const RpcError& e) {
+        return errorResponse(id, e.code, e.message);
+    } catch (const std::exception& e) {
+        return errorResponse(id, ServerError, e.what());
+    }
+}
+
+void PlannerDaemon::stop() {
+    running = false;
+}
+
+void PlannerDaemon::flush() {
+    stores.flush();
+}
+
+#ifdef _WIN32
+
+void PlannerDaemon::serve(const std::string&) {
+    throw FileException("Daemon mode requires Unix domain sockets, which this build does not support.");
+}
+
+#else
+
+void PlannerDaemon::serve(const std::string& socketPath) {
+    sockaddr_un address{};
+    if (socketPath.size() >= sizeof(address.sun_path))
+        throw FileException("Socket path too long: " + socketPath);
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+        throw FileException(std::string("Could not create socket: ") + std::strerror(errno));
+
+    ::unlink(socketPath.c_str()); // Remove a stale socket left by a previous run
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(listener, 16) < 0) {
+        std::string reason = std::strerror(errno);
+        ::close(listener);
+        throw FileException("Could not listen on " + socketPath + ": " + reason);
+    }
+
+    // Connected clients with their partially received request line and unsent responses
+    struct Client {
+        int fd;
+        std::string pending;
+        std::string output;
+        bool closing = false; // The client stopped sending; close once its responses are out
+    };
+    std::vector<Client> clients;
+
+    // Send what the socket takes without blocking; false when the client is gone
+    auto flushOutput = [](Client& client) {
+        while (!client.output.empty()) {
+            ssize_t n = ::send(client.fd, client.output.data(), client.output.size(), MSG_NOSIGNAL);
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+                return true;
+            if (n <= 0)
+                return false;
+            client.output.erase(0, static_cast<std::size_t>(n));
+        }
+        return true;
+    };
+
+    running = true;
+    while (running) {
+        std::vector<pollfd> fds;
+        fds.push_back({listener, POLLIN, 0});
+        for (const auto& client : clients) {
+            // A client that does not read its responses is not read from either
+            short events = client.closing || client.output.size() >= MaxPendingOutput ? 0 : POLLIN;
+            if (!client.output.empty())
+                events |= POLLOUT;
+            fds.push_back({client.fd, events, 0});
+        }
+
+        // Wake up regularly so stop() from another thread is noticed and aging edits are saved
+        stores.flushExpired();
+        int ready = ::poll(fds.data(), fds.size(), 200);
+        if (ready < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd = ::accept(listener, nullptr, nullptr);
+            if (fd >= 0) {
+                // One slow client must never stall the others
+                ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+                clients.push_back({fd, std::string(), std::string(), false});
+            }
+        }
+
+        for (std::size_t i = 1; i < fds.size(); ++i) {
+            Client& client = clients[i - 1];
+            bool alive = true;
+
+            if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                char chunk[4096];
+                ssize_t received = ::recv(client.fd, chunk, sizeof(chunk), 0);
+                if (received == 0 || (fds[i].revents & POLLERR)) {
+                    client.closing = true;
+                } else if (received < 0) {
+                    alive = errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+                } else {
+                    client.pending.append(chunk, static_cast<std::size_t>(received));
+
+                    std::size_t newline;
+                    while ((newline = client.pending.find('\n')) != std::string::npos) {
+                        std::string line = client.pending.substr(0, newline);
+                        client.pending.erase(0, newline + 1);
+                        if (!line.empty())
+                            client.output += handleRequest(line) + "\n";
+                    }
+                    if (client.pending.size() > MaxRequestBytes)
+                        alive = false; // No request is this long; drop the client rather than buffer it
+                }
+            }
+
+            if (alive)
+                alive = flushOutput(client);
+            if (!alive || (client.closing && client.output.empty())) {
+                ::close(client.fd);
+                client.fd = -1;
+            }
+        }
+
+        clients.erase(std::remove_if(clients.begin(), clients.end(), [](const Client& client) { return client.fd < 0; }),
+                      clients.end());
+    }
+
+    for (auto& client : clients) {
+        flushOutput(client); // Best effort, e.g. the response to shutdown
+        ::close(client.fd);
+    }
+    ::close(listener);
+    ::unlink(socketPath.c_str());
+    flush();
+}
+
+#endif
@@ -0,0 +1,221 @@
+#include "../include/priorityrules.hpp"
+#include "../include/json.hpp"
+#include "FileException.hpp"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+namespace {
+    // Widest range of thresholds an integer factor may span, bounding its table size
+    constexpr int MaxThreshold = 1 << 16;
+
+    const char* const DefaultRules = R"({
+        "deadline": [{"below": 2, "points": 10}, {"below": 4, "points": 8},
+                     {"below": 6, "points": 6}, {"below": 8, "points": 4}],
+        "slack":    [{"below": 2, "points": 20}, {"below": 4, "points": 15},
+                     {"below": 6, "points": 10}],
+        "weight":   [{"above": 20, "points": 6}, {"above": 15, "points": 4},
+                     {"above": 10, "points": 2}],
+        "size":     [{"equals": 1, "points": 3}, {"equals": 2, "points": 2},
+                     {"equals": 3, "points": 1}]
+    })";
+
+    enum class Comparison { Below, Above, Equals };
+
+    template <typename Value>
+    struct Rule {
+        Comparison comparison;
+        Value threshold;
+        int points;
+
+        bool matches(Value value) const {
+            switch (comparison) {
+                case Comparison::Below: return value < threshold;
+                case Comparison::Above: return value > threshold;
+                case Comparison::Equals: return value == threshold;
+            }
+            return false;
+        }
+    };
+
+    template <typename Value>
+    int firstMatch(const std::vector<Rule<Value>>& rules, Value value) {
+        for (const auto& rule : rules) {
+            if (rule.matches(value))
+                return rule.points;
+        }
+        return 0;
+    }
+
+    template <typename Value>
+    std::vector<Rule<Value>> parseRules(const json& config, const std::string& factor, bool allowIntegerComparisons) {
+        std::vector<Rule<Value>> rules;
+        if (!config.contains(factor))
+            return rules;
+
+        const json& list = config.at(factor);
+        if (!list.is_array())
+            throw std::invalid_argument("Priority rules: \"" + factor + "\" must be an array of rules");
+
+        for (const auto& entry : list) {
+            if (!entry.is_object() || !entry.contains("points") || !entry.at("points").is_number_integer() || entry.size() != 2)
+                throw std::invalid_argument("Priority rules: each \"" + factor + "\" rule needs one comparison and integer \"points\"");
+
+            Rule<Value> rule{Comparison::Below, Value(), entry.at("points").get<int>()};
+            const char* key = nullptr;
+            if (entry.contains("above")) {
+                rule.comparison = Comparison::Above;
+                key = "above";
+            } else if (allowIntegerComparisons && entry.contains("below")) {
+                rule.comparison = Comparison::Below;
+                key = "below";
+            } else if (allowIntegerComparisons && entry.contains("equals")) {
+                rule.comparison = Comparison::Equals;
+                key = "equals";
+            } else {
+                throw std::invalid_argument("Priority rules: unsupported comparison in \"" + factor + "\"");
+            }
+
+            const json& threshold = entry.at(key);
+            if (allowIntegerComparisons ? !threshold.is_number_integer() : !threshold.is_number())
+                throw std::invalid_argument("Priority rules: bad threshold in \"" + factor + "\"");
+            rule.threshold = threshold.get<Value>();
+            if (allowIntegerComparisons && (rule.threshold < -MaxThreshold || rule.threshold > MaxThreshold))
+                throw std::invalid_argument("Priority rules: threshold out of range in \"" + factor + "\"");
+            rules.push_back(rule);
+        }
+        return rules;
+    }
+
+    // Evaluate the rules once for every value between the extreme thresholds (plus one on
+    // each side); any value further out compares exactly like the nearest end
+    PriorityRules::IntTable compileInt(const std::vector<Rule<int>>& rules) {
+        PriorityRules::IntTable table;
+        if (rules.empty())
+            return table;
+
+        int lowest = rules.front().threshold, highest = rules.front().threshold;
+        for (const auto& rule : rules) {
+            lowest = std::min(lowest, rule.threshold);
+            highest = std::max(highest, rule.threshold);
+        }
+        table.low = lowest - 1;
+        table.high = highest + 1;
+        table.points.clear();
+        for (int value = table.low; value <= table.high; ++value)
+            table.points.push_back(firstMatch(rules, value));
+
+        // Runs of equal points; the end entries stand for everything beyond them
+        const std::size_t size = table.points.size();
+        table.runStart.assign(size, LLONG_MIN);
+        table.runEnd.assign(size, LLONG_MAX);
+        for (std::size_t i = 1; i < size; ++i) {
+            if (table.points[i] == table.points[i - 1])
+                table.runStart[i] = table.runStart[i - 1];
+            else
+                table.runStart[i] = table.low + static_cast<long long>(i);
+        }
+        for (std::size_t i = size - 1; i-- > 0;) {
+            if (table.points[i] == table.points[i + 1])
+                table.runEnd[i] = table.runEnd[i + 1];
+            else
+                table.runEnd[i] = table.low + static_cast<long long>(i);
+        }
+        return table;
+    }
+}
+
+PriorityRules::PriorityRules() : PriorityRules(fromJson(DefaultRules)) {}
+
+PriorityRules::PriorityRules(Empty) {}
+
+PriorityRules PriorityRules::fromJson(const std::string& text) {
+    json config;
+    try {
+        config = json::parse(text);
+    } catch (const json::exception& e) {
+        throw std::invalid_argument(std::string("Priority rules: ") + e.what());
+    }
+    if (!config.is_object())
+        throw std::invalid_argument("Priority rules: expected a JSON object");
+    for (const auto& item : config.items()) {
+        const std::string& factor = item.key();
+        if (factor != "deadline" && factor != "slack" && factor != "weight" && factor != "size")
+            throw std::invalid_argument("Priority rules: unknown factor \"" + factor + "\"");
+    }
+
+    PriorityRules rules{Empty()};
+    rules.deadlineTable = compileInt(parseRules<int>(config, "deadline", true));
+    rules.slackTable = compileInt(parseRules<int>(config, "slack", true));
+    rules.sizeTable = compileInt(parseRules<int>(config, "size", true));
+
+    // A weight's bucket is the number of thresholds it exceeds, which fixes every "above" outcome
+    auto weightRules = parseRules<float>(config, "weight", false);
+    for (const auto& rule : weightRules)
+        rules.weightThresholds.push_back(rule.threshold);
+    std::sort(rules.weightThresholds.begin(), rules.weightThresholds.end());
+    rules.weightPoints.assign(rules.weightThresholds.size() + 1, 0);
+    for (std::size_t bucket = 0; bucket < rules.weightPoints.size(); ++bucket) {
+        for (const auto& rule : weightRules) {
+            if (bucket > 0 && rules.weightThresholds[bucket - 1] >= rule.threshold) {
+                rules.weightPoints[bucket] = rule.points;
+                break;
+            }
+        }
+    }
+    return rules;
+}
+
+int PriorityRules::stableDays(int deadline, int realDuration, int studyHoursPerDay, int minHours, int maxHours) const {
+    // An assignment with deadline d is scored again at most d - 1 more times before it is dropped,
+    // always with a positive remaining deadline x = d - t
+    long long days = std::max(0, deadline - 1);
+
+    // Deadline points hold while the deadline stays within its run
+    auto deadlineIndex = std::clamp(deadline, deadlineTable.low, deadlineTable.high) - deadlineTable.low;
+    if (deadlineTable.runStart[deadlineIndex] != LLONG_MIN)
+        days = std::min(days, deadline - deadlineTable.runStart[deadlineIndex]);
+
+    // Slack x * hours - duration stays within [x * minHours, x * maxHours] - duration,
+    // which shrinks towards lower values as x falls
+    long long slack = static_cast<long long>(deadline) * studyHoursPerDay - realDuration;
+    auto slackIndex = std::clamp<long long>(slack, slackTable.low, slackTable.high) - slackTable.low;
+    long long runStart = slackTable.runStart[slackIndex];
+    long long runEnd = slackTable.runEnd[slackIndex];
+
+    if (runEnd != LLONG_MAX && (static_cast<long long>(deadline) - 1) * maxHours - realDuration > runEnd)
+        return 0; // Tomorrow's hours may already lift the slack out of its run
+    if (runStart != LLONG_MIN) {
+        // Need (d - t) * minHours - duration >= runStart, i.e. t <= d - ceil((runStart + duration) / minHours)
+        long long needed = runStart + realDuration;
+        if (needed > 0 && minHours <= 0)
+            return 0; // A day without hours can drop the slack to -duration, below the run
+        long long minX = needed <= 0 ? LLONG_MIN / 4 : (needed + minHours - 1) / minHours;
+        days = std::min(days, deadline - minX);
+    }
+    return static_cast<int>(std::max(0LL, days));
+}
+
+PriorityRules PriorityRules::fromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open())
+        throw FileException("Could not open priority rules file " + filename);
+    return fromJson(std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()));
+}
+
+namespace {
+    PriorityRules& activeRules() {
+        static PriorityRules rules;
+        return rules;
+    }
+}
+
+const PriorityRules& PriorityRules::active() {
+    return activeRules();
+}
+
+void PriorityRules::setActive(const PriorityRules& rules) {
+    activeRules() = rules;
+}
@@ -0,0 +1,314 @@
+#include "../include/scheduleengine.hpp"
+#include "../include/planner.hpp"
+#include "../include/arena.hpp"
+#include "../include/priorityrules.hpp"
+#include <algorithm>
+#include <climits>
+#include <queue>
+
+int Planner::studyHoursForDay(int day, int weekdayStudyHours, int weekendStudyHours) {
+    return (day % 6 == 0 || day % 7 == 0) ? weekendStudyHours : weekdayStudyHours;
+}
+
+namespace {
+    // Per-assignment scheduling state, one array per field, in the run's scratch arena
+    struct FlatState {
+        std::pmr::vector<int> deadline, remaining, size;
+        std::pmr::vector<float> weight;
+
+        FlatState(std::size_t count, std::pmr::memory_resource* scratch)
+            : deadline(count, scratch), remaining(count, scratch), size(count, scratch), weight(count, scratch) {}
+    };
+
+    // Scheduler core working on flat per-assignment state instead of shared objects.
+    // Heap operations mirror std::priority_queue step for step so ties break exactly as in the reference.
+    // `hoursOn(day)` gives each day's study hours, which always lie within [minHours, maxHours].
+    template <typename HoursOn>
+    Planner::ScheduleResult scheduleFlat(FlatState& state, std::pmr::memory_resource* scratch,
+                                         HoursOn hoursOn, int minHours, int maxHours) {
+        using namespace Planner;
+        ScheduleResult result;
+        const std::size_t count = state.deadline.size();
+        std::pmr::vector<int>& deadline = state.deadline;
+        std::pmr::vector<int>& remaining = state.remaining;
+        std::pmr::vector<int>& size = state.size;
+        std::pmr::vector<float>& weight = state.weight;
+        std::pmr::vector<int> priority(count, scratch);
+        const PriorityRules& rules = PriorityRules::active();
+
+        // Kinetic priorities: an assignment is only rescored on the day its score may next change.
+        // The bound assumes every day has between minHours and maxHours; with negative hours
+        // everything is rescored daily.
+        const bool kinetic = minHours >= 0;
+        std::pmr::vector<int> rescoreDay(count, 0, scratch);
+
+        // Unfinished assignments in their original order, and those completed during the current day
+        std::pmr::vector<std::size_t> active(count, scratch);
+        for (std::size_t i = 0; i < count; ++i)
+            active[i] = i;
+        std::pmr::vector<char> completed(count, 0, scratch);
+
+        auto compare = [&priority](std::size_t a, std::size_t b) {
+            return priority[a] < priority[b];
+        };
+        std::pmr::vector<std::size_t> heap(scratch);
+        heap.reserve(count);
+
+        int day = 1;
+        while (!active.empty()) {
+            int studyHours = hoursOn(day);
+
+            // The heap is still rebuilt in the same push order every day so ties break as before
+            heap.clear();
+            for (std::size_t index : active) {
+                if (rescoreDay[index] <= day) {
+                    priority[index] = rules.score(deadline[index], remaining[index], weight[index], size[index], studyHours);
+                    int stable = kinetic ? rules.stableDays(deadline[index], remaining[index], studyHours, minHours, maxHours) : 0;
+                    rescoreDay[index] = day + 1 + std::min(stable, INT_MAX - day - 1);
+                }
+                heap.push_back(index);
+                std::push_heap(heap.begin(), heap.end(), compare);
+            }
+
+            for (int i = 0; i < studyHours; ++i) {
+                if (heap.empty())
+                    break;
+
+                std::size_t current = heap.front();
+                std::pop_heap(heap.begin(), heap.end(), compare);
+                heap.pop_back();
+
+                result.slots.push_back({day, i, current});
+                remaining[current] -= 1;
+
+                if (remaining[current] <= 0) {
+                    completed[current] = 1;
+                } else {
+                    priority[current] = rules.score(deadline[current], remaining[current], weight[current], size[current], studyHours);
+                    rescoreDay[current] = day + 1; // Its remaining duration changed
+                    heap.push_back(current);
+                    std::push_heap(heap.begin(), heap.end(), compare);
+                }
+            }
+
+            // Drop completed assignments and age the rest, keeping their order
+            std::size_t kept = 0;
+            for (std::size_t index : active) {
+                if (completed[index])
+                    continue;
+
+                deadline[index] -= 1;
+                if (deadline[index] <= 0)
+                    result.missed.push_back({day, index});
+                else
+                    active[kept++] = index;
+            }
+            active.resize(kept);
+
+            ++day;
+        }
+
+        result.days = day - 1;
+        return result;
+    }
+
+    FlatState flatten(const std::vector<Planner::AssignmentPtr>& assignments, std::pmr::memory_resource* scratch) {
+        FlatState state(assignments.size(), scratch);
+        for (std::size_t i = 0; i < assignments.size(); ++i) {
+            state.deadline[i] = assignments[i]->getDeadline();
+            state.remaining[i] = assignments[i]->getRealDuration();
+            state.weight[i] = assignments[i]->getWeight();
+            state.size[i] = assignments[i]->getSize();
+        }
+        return state;
+    }
+
+    FlatState flatten(const std::vector<AssignmentView>& assignments, std::pmr::memory_resource* scratch) {
+        FlatState state(assignments.size(), scratch);
+        for (std::size_t i = 0; i < assignments.size(); ++i) {
+            state.deadline[i] = assignments[i].deadline;
+            state.remaining[i] = assignments[i].realDuration();
+            state.weight[i] = assignments[i].weight;
+            state.size[i] = assignments[i].size;
+        }
+        return state;
+    }
+
+    // Weekday/weekend hours by the legacy day-number rule
+    template <typename Assignments>
+    Planner::ScheduleResult scheduleLegacy(const Assignments& assignments, int weekdayStudyHours, int weekendStudyHours) {
+        ScratchArena arena;
+        FlatState state = flatten(assignments, arena.resource());
+        auto hoursOn = [weekdayStudyHours, weekendStudyHours](int day) {
+            return Planner::studyHoursForDay(day, weekdayStudyHours, weekendStudyHours);
+        };
+        return scheduleFlat(state, arena.resource(), hoursOn,
+                            std::min(weekdayStudyHours, weekendStudyHours), std::max(weekdayStudyHours, weekendStudyHours));
+    }
+
+    // One array load per day from a precomputed capacity vector
+    template <typename Assignments>
+    Planner::ScheduleResult scheduleCapacity(const Assignments& assignments, const Planner::DayCapacity& capacity) {
+        ScratchArena arena;
+        FlatState state = flatten(assignments, arena.resource());
+        const std::size_t days = capacity.size();
+        int minHours = INT_MAX, maxHours = 0;
+        for (int hours : capacity) {
+            minHours = std::min(minHours, hours);
+            maxHours = std::max(maxHours, hours);
+        }
+        if (static_cast<std::size_t>(Planner::scheduleHorizon(assignments)) > days)
+            minHours = std::min(minHours, 0); // Days past the vector have no hours
+        auto hoursOn = [&capacity, days](int day) {
+            return static_cast<std::size_t>(day) <= days ? capacity[static_cast<std::size_t>(day) - 1] : 0;
+        };
+        return scheduleFlat(state, arena.resource(), hoursOn, minHours, maxHours);
+    }
+}
+
+int Planner::scheduleHorizon(const std::vector<AssignmentPtr>& assignments) {
+    int days = assignments.empty() ? 0 : 1;
+    for (const auto& assignment : assignments)
+        days = std::max(days, assignment->getDeadline());
+    return days;
+}
+
+int Planner::scheduleHorizon(const std::vector<AssignmentView>& assignments) {
+    int days = assignments.empty() ? 0 : 1;
+    for (const auto& assignment : assignments)
+        days = std::max(days, assignment.deadline);
+    return days;
+}
+
+Planner::ScheduleResult Planner::computeSchedule(const std::vector<AssignmentPtr>& assignments, int weekdayStudyHours, int weekendStudyHours) {
+    return scheduleLegacy(assignments, weekdayStudyHours, weekendStudyHours);
+}
+
+Planner::ScheduleResult Planner::computeSchedule(const std::vector<AssignmentView>& assignments, int weekdayStudyHours, int weekendStudyHours) {
+    return scheduleLegacy(assignments, weekdayStudyHours, weekendStudyHours);
+}
+
+Planner::ScheduleResult Planner::computeSchedule(const std::vector<AssignmentPtr>& assignments, const DayCapacity& capacity) {
+    return scheduleCapacity(assignments, capacity);
+}
+
+Planner::ScheduleResult Planner::computeSchedule(const std::vector<AssignmentView>& assignments, const DayCapacity& capacity) {
+    return scheduleCapacity(assignments, capacity);
+}
+
+int Planner::referencePriority(int deadline, int realDuration, float weight, int size, int studyHoursPerDay) {
+    int remainingHours = deadline * studyHoursPerDay;
+    int priority = 0;
+
+    // Add priority based on deadline
+    if (deadline < 2)
+        priority += 10;
+    else if (deadline < 4)
+        priority += 8;
+    else if (deadline < 6)
+        priority += 6;
+    else if (deadline < 8)
+        priority += 4;
+
+    // Add priority based on remaining time
+    if ((remainingHours - realDuration) < 2)
+        priority += 20;
+    else if ((remainingHours - realDuration) < 4)
+        priority += 15;
+    else if ((remainingHours - realDuration) < 6)
+        priority += 10;
+
+    // Add priority based on weight
+    if (weight > 20)
+        priority += 6;
+    else if (weight > 15)
+        priority += 4;
+    else if (weight > 10)
+        priority += 2;
+
+    // Add priority based on size
+    if (size == 1)
+        priority += 3;
+    else if (size == 2)
+        priority += 2;
+    else if (size == 3)
+        priority += 1;
+
+    return priority;
+}
+
+namespace {
+    template <typename HoursOn>
+    Planner::ScheduleResult referenceScheduleWith(const std::vector<Planner::AssignmentPtr>& assignments, HoursOn hoursOn) {
+        using namespace Planner;
+        ScheduleResult result;
+
+        auto indexOf = [&assignments](const AssignmentPtr& assignment) {
+            return static_cast<std::size_t>(std::find(assignments.begin(), assignments.end(), assignment) - assignments.begin());
+        };
+
+        std::vector<AssignmentPtr> assignmentList(assignments);
+        int day = 1;
+
+        while (!assignmentList.empty()) {
+            int studyHours = hoursOn(day);
+            auto compare = [](const AssignmentPtr& a, const AssignmentPtr& b) {
+                return a->getPriority() < b->getPriority();
+            };
+            std::priority_queue<AssignmentPtr, std::vector<AssignmentPtr>, decltype(compare)> priorityQueue(compare);
+
+            for (const auto& assignment : assignmentList) {
+                int priority = calculatePriority(*assignment, studyHours);
+                assignment->setPriority(priority);
+                priorityQueue.push(assignment);
+            }
+
+            for (int i = 0; i < studyHours; ++i) {
+                if (priorityQueue.empty())
+                    break;
+
+                auto currentAssignment = priorityQueue.top();
+                priorityQueue.pop();
+
+                result.slots.push_back({day, i, indexOf(currentAssignment)});
+                currentAssignment->decreaseDuration(1);
+
+                if (currentAssignment->getRealDuration() <= 0) {
+                    auto it = std::find(assignmentList.begin(), assignmentList.end(), currentAssignment);
+                    if (it != assignmentList.end())
+                        assignmentList.erase(it);
+                } else {
+                    currentAssignment->setPriority(calculatePriority(*currentAssignment, studyHours));
+                    priorityQueue.push(currentAssignment);
+                }
+            }
+
+            for (auto it = assignmentList.begin(); it != assignmentList.end();) {
+                (*it)->decreaseDeadline(1);
+                if ((*it)->getDeadline() <= 0) {
+                    result.missed.push_back({day, indexOf(*it)});
+                    it = assignmentList.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+
+            ++day;
+        }
+
+        result.days = day - 1;
+        return result;
+    }
+}
+
+Planner::ScheduleResult Planner::referenceSchedule(const std::vector<AssignmentPtr>& assignments, int weekdayStudyHours, int weekendStudyHours) {
+    return referenceScheduleWith(assignments, [weekdayStudyHours, weekendStudyHours](int day) {
+        return (day % 6 == 0 || day % 7 == 0) ? weekendStudyHours : weekdayStudyHours;
+    });
+}
+
+Planner::ScheduleResult Planner::referenceSchedule(const std::vector<AssignmentPtr>& assignments, const DayCapacity& capacity) {
+    return referenceScheduleWith(assignments, [&capacity](int day) {
+        return static_cast<std::size_t>(day) <= capacity.size() ? capacity[static_cast<std::size_t>(day) - 1] : 0;
+    });
+}
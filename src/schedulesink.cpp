@@ -0,0 +1,287 @@
+#include "../include/schedulesink.hpp"
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+    // Zero-padded decimal of a fixed width (at most 8); throws std::out_of_range for values that do not fit
+    void appendDigits(OutputBuffer& buffer, int value, int width) {
+        int limit = 1;
+        for (int i = 0; i < width; ++i)
+            limit *= 10;
+        if (value < 0 || value >= limit)
+            throw std::out_of_range("Schedule date field out of range: " + std::to_string(value));
+
+        char digits[8];
+        for (int i = width - 1; i >= 0; --i) {
+            digits[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        buffer.append(std::string_view(digits, width));
+    }
+
+    void appendDate(OutputBuffer& buffer, const CivilDate& date) {
+        appendDigits(buffer, date.year, 4);
+        buffer.append('-');
+        appendDigits(buffer, date.month, 2);
+        buffer.append('-');
+        appendDigits(buffer, date.day, 2);
+    }
+
+    // YYYY-MM-DDTHH:MM of `minute` minutes after midnight of `date`
+    void appendLocalTime(OutputBuffer& buffer, const CivilDate& date, int minute) {
+        appendDate(buffer, date.plusDays(minute / 1440));
+        minute %= 1440;
+        buffer.append('T');
+        appendDigits(buffer, minute / 60, 2);
+        buffer.append(':');
+        appendDigits(buffer, minute % 60, 2);
+    }
+
+    // Fields with separators, quotes or line breaks are quoted, doubling inner quotes
+    void appendCsvField(OutputBuffer& buffer, std::string_view text) {
+        if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+            buffer.append(text);
+            return;
+        }
+        buffer.append('"');
+        for (char c : text) {
+            if (c == '"')
+                buffer.append('"');
+            buffer.append(c);
+        }
+        buffer.append('"');
+    }
+
+    void appendLittleEndian(OutputBuffer& buffer, std::uint64_t value, int bytes) {
+        char data[8];
+        for (int i = 0; i < bytes; ++i)
+            data[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        buffer.append(std::string_view(data, bytes));
+    }
+
+    // A record field, checked against the range of its binary type
+    template <typename Field>
+    Field narrow(int value, const char* name) {
+        if (value < 0 || value > std::numeric_limits<Field>::max())
+            throw std::out_of_range(std::string("Schedule timeline ") + name + " out of range: " + std::to_string(value));
+        return static_cast<Field>(value);
+    }
+
+    std::uint64_t readLittleEndian(const char* data, int bytes) {
+        std::uint64_t value = 0;
+        for (int i = bytes - 1; i >= 0; --i)
+            value = (value << 8) | static_cast<unsigned char>(data[i]);
+        return value;
+    }
+}
+
+TeeScheduleSink::TeeScheduleSink(std::vector<ScheduleSink*> sinks) : sinks(std::move(sinks)) {}
+
+void TeeScheduleSink::begin(const Assignments& assignments, const CivilDate& baseDate) {
+    for (ScheduleSink* sink : sinks)
+        sink->begin(assignments, baseDate);
+}
+
+void TeeScheduleSink::day(int day) {
+    for (ScheduleSink* sink : sinks)
+        sink->day(day);
+}
+
+void TeeScheduleSink::session(const ScheduledSession& session) {
+    for (ScheduleSink* sink : sinks)
+        sink->session(session);
+}
+
+void TeeScheduleSink::missed(const MissedDeadline& missed) {
+    for (ScheduleSink* sink : sinks)
+        sink->missed(missed);
+}
+
+void TeeScheduleSink::finish() {
+    for (ScheduleSink* sink : sinks)
+        sink->finish();
+}
+
+BufferedScheduleSink::BufferedScheduleSink(std::ostream& out) : buffer(out) {}
+
+void BufferedScheduleSink::begin(const Assignments& assignments, const CivilDate& baseDate) {
+    this->assignments = &assignments;
+    this->baseDate = baseDate;
+}
+
+void BufferedScheduleSink::finish() {
+    buffer.flush();
+}
+
+IcsScheduleSink::IcsScheduleSink(std::ostream& out, bool compress, std::vector<IcsEvent> previous)
+    : BufferedScheduleSink(out), compress(compress), previous(std::move(previous)) {}
+
+void IcsScheduleSink::session(const ScheduledSession& session) {
+    sessions.push_back({session.assignment, session.day, session.startMinute, session.endMinute});
+}
+
+void IcsScheduleSink::finish() {
+    std::vector<IcsEvent> events = IcsSchedule::buildEvents(sessions, *assignments, baseDate, compress);
+    changes = IcsSchedule::diff(previous, events);
+    IcsSchedule::writeCalendar(buffer, events, baseDate);
+    buffer.flush();
+}
+
+void CsvScheduleSink::begin(const Assignments& assignments, const CivilDate& baseDate) {
+    BufferedScheduleSink::begin(assignments, baseDate);
+    buffer.append("kind,date,start,end,subject,name,id\n");
+}
+
+void CsvScheduleSink::session(const ScheduledSession& session) {
+    const Assignment& assignment = *(*assignments)[session.assignment];
+    const CivilDate date = baseDate.plusDays(session.day);
+    buffer.append("session,");
+    appendDate(buffer, date);
+    buffer.append(',');
+    appendLocalTime(buffer, date, session.startMinute);
+    buffer.append(',');
+    appendLocalTime(buffer, date, session.endMinute);
+    buffer.append(',');
+    appendCsvField(buffer, assignment.getSubject());
+    buffer.append(',');
+    appendCsvField(buffer, assignment.getName());
+    buffer.append(',').appendUnsigned(assignment.getId()).append('\n');
+    buffer.flushIfFull();
+}
+
+void CsvScheduleSink::missed(const MissedDeadline& missed) {
+    const Assignment& assignment = *(*assignments)[missed.assignment];
+    buffer.append("missed,");
+    appendDate(buffer, baseDate.plusDays(missed.day));
+    buffer.append(",,,");
+    appendCsvField(buffer, assignment.getSubject());
+    buffer.append(',');
+    appendCsvField(buffer, assignment.getName());
+    buffer.append(',').appendUnsigned(assignment.getId()).append('\n');
+    buffer.flushIfFull();
+}
+
+void NdjsonScheduleSink::session(const ScheduledSession& session) {
+    const Assignment& assignment = *(*assignments)[session.assignment];
+    const CivilDate date = baseDate.plusDays(session.day);
+    buffer.append("{\"kind\":\"session\",\"date\":\"");
+    appendDate(buffer, date);
+    buffer.append("\",\"start\":\"");
+    appendLocalTime(buffer, date, session.startMinute);
+    buffer.append("\",\"end\":\"");
+    appendLocalTime(buffer, date, session.endMinute);
+    buffer.append("\",\"hour\":").appendInt(session.hour);
+    buffer.append(",\"subject\":").appendJsonString(assignment.getSubject());
+    buffer.append(",\"name\":").appendJsonString(assignment.getName());
+    buffer.append(",\"id\":").appendUnsigned(assignment.getId()).append("}\n");
+    buffer.flushIfFull();
+}
+
+void NdjsonScheduleSink::missed(const MissedDeadline& missed) {
+    const Assignment& assignment = *(*assignments)[missed.assignment];
+    buffer.append("{\"kind\":\"missed\",\"date\":\"");
+    appendDate(buffer, baseDate.plusDays(missed.day));
+    buffer.append("\",\"subject\":").appendJsonString(assignment.getSubject());
+    buffer.append(",\"name\":").appendJsonString(assignment.getName());
+    buffer.append(",\"id\":").appendUnsigned(assignment.getId()).append("}\n");
+    buffer.flushIfFull();
+}
+
+void BinaryScheduleSink::begin(const Assignments& assignments, const CivilDate& baseDate) {
+    BufferedScheduleSink::begin(assignments, baseDate);
+    buffer.append("SPTL").append(static_cast<char>(Version));
+    appendLittleEndian(buffer, static_cast<std::uint32_t>(static_cast<std::int32_t>(baseDate.toDays())), 4);
+}
+
+void BinaryScheduleSink::session(const ScheduledSession& session) {
+    record({TimelineRecord::Session, narrow<std::uint8_t>(session.hour, "hour"), narrow<std::uint16_t>(session.day, "day"),
+            narrow<std::uint16_t>(session.startMinute, "start minute"), narrow<std::uint16_t>(session.endMinute, "end minute"),
+            (*assignments)[session.assignment]->getId()});
+}
+
+void BinaryScheduleSink::missed(const MissedDeadline& missed) {
+    record({TimelineRecord::Missed, 0, narrow<std::uint16_t>(missed.day, "day"), 0, 0,
+            (*assignments)[missed.assignment]->getId()});
+}
+
+void BinaryScheduleSink::record(const TimelineRecord& record) {
+    appendLittleEndian(buffer, record.kind, 1);
+    appendLittleEndian(buffer, record.hour, 1);
+    appendLittleEndian(buffer, record.day, 2);
+    appendLittleEndian(buffer, record.startMinute, 2);
+    appendLittleEndian(buffer, record.endMinute, 2);
+    appendLittleEndian(buffer, record.id, 8);
+    buffer.flushIfFull();
+}
+
+std::vector<TimelineRecord> BinaryScheduleSink::read(std::string_view data, CivilDate* baseDate) {
+    if (data.size() < HeaderSize || data.substr(0, 4) != "SPTL")
+        throw std::invalid_argument("Not a schedule timeline");
+    if (static_cast<std::uint8_t>(data[4]) != Version)
+        throw std::invalid_argument("Unsupported schedule timeline version " + std::to_string(static_cast<unsigned char>(data[4])));
+    if ((data.size() - HeaderSize) % RecordSize != 0)
+        throw std::invalid_argument("Truncated schedule timeline");
+
+    if (baseDate)
+        *baseDate = CivilDate::fromDays(static_cast<std::int32_t>(readLittleEndian(data.data() + 5, 4)));
+
+    std::vector<TimelineRecord> records;
+    records.reserve((data.size() - HeaderSize) / RecordSize);
+    for (std::size_t offset = HeaderSize; offset < data.size(); offset += RecordSize) {
+        const char* p = data.data() + offset;
+        TimelineRecord record;
+        record.kind = static_cast<TimelineRecord::Kind>(readLittleEndian(p, 1));
+        record.hour = static_cast<std::uint8_t>(readLittleEndian(p + 1, 1));
+        record.day = static_cast<std::uint16_t>(readLittleEndian(p + 2, 2));
+        record.startMinute = static_cast<std::uint16_t>(readLittleEndian(p + 4, 2));
+        record.endMinute = static_cast<std::uint16_t>(readLittleEndian(p + 6, 2));
+        record.id = readLittleEndian(p + 8, 8);
+        records.push_back(record);
+    }
+    return records;
+}
+
+ScheduleExport::Format ScheduleExport::parseFormat(std::string_view name) {
+    if (name == "ics")
+        return Format::Ics;
+    if (name == "csv")
+        return Format::Csv;
+    if (name == "ndjson")
+        return Format::Ndjson;
+    if (name == "binary")
+        return Format::Binary;
+    if (name == "null")
+        return Format::Null;
+    throw std::invalid_argument("Unknown schedule format: " + std::string(name));
+}
+
+ScheduleExport::Format ScheduleExport::parseFileFormat(std::string_view name) {
+    Format format = parseFormat(name);
+    if (format == Format::Ics || format == Format::Null)
+        throw std::invalid_argument("Schedule format " + std::string(name) + " cannot be exported to a file; use csv, ndjson or binary");
+    return format;
+}
+
+const char* ScheduleExport::extension(Format format) {
+    switch (format) {
+        case Format::Ics: return "ics";
+        case Format::Csv: return "csv";
+        case Format::Ndjson: return "ndjson";
+        case Format::Binary: return "timeline";
+        case Format::Null: break;
+    }
+    return "";
+}
+
+std::unique_ptr<ScheduleSink> ScheduleExport::makeSink(Format format, std::ostream& out) {
+    switch (format) {
+        case Format::Ics: return std::make_unique<IcsScheduleSink>(out, true);
+        case Format::Csv: return std::make_unique<CsvScheduleSink>(out);
+        case Format::Ndjson: return std::make_unique<NdjsonScheduleSink>(out);
+        case Format::Binary: return std::make_unique<BinaryScheduleSink>(out);
+        case Format::Null: break;
+    }
+    return std::make_unique<NullScheduleSink>();
+}
@@ -0,0 +1,222 @@
+#include "../include/studycalendar.hpp"
+#include "../include/json.hpp"
+#include "FileException.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+using json = nlohmann::json;
+
+// Days-from-civil and civil-from-days after Howard Hinnant's public-domain algorithms
+CivilDate CivilDate::fromDays(long long days) {
+    days += 719468;
+    const long long era = (days >= 0 ? days : days - 146096) / 146097;
+    const long long dayOfEra = days - era * 146097;
+    const long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const long long monthIndex = (5 * dayOfYear + 2) / 153; // March = 0
+    CivilDate date;
+    date.day = static_cast<int>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    date.month = static_cast<int>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+    date.year = static_cast<int>(yearOfEra + era * 400 + (date.month <= 2 ? 1 : 0));
+    return date;
+}
+
+long long CivilDate::toDays() const {
+    const long long y = static_cast<long long>(year) - (month <= 2 ? 1 : 0);
+    const long long era = (y >= 0 ? y : y - 399) / 400;
+    const long long yearOfEra = y - era * 400;
+    const long long dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+int CivilDate::weekday() const {
+    const long long days = toDays();
+    return static_cast<int>(days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6); // 1970-01-01 was a Thursday
+}
+
+CivilDate CivilDate::plusDays(long long days) const {
+    return fromDays(toDays() + days);
+}
+
+CivilDate CivilDate::today() {
+    std::time_t now = std::time(nullptr);
+    std::tm* local = std::localtime(&now);
+    return CivilDate{local->tm_year + 1900, local->tm_mon + 1, local->tm_mday};
+}
+
+CivilDate CivilDate::parse(std::string_view text) {
+    auto number = [&text](std::size_t offset, std::size_t length) {
+        int value = 0;
+        const char* begin = text.data() + offset;
+        auto result = std::from_chars(begin, begin + length, value);
+        if (result.ec != std::errc() || result.ptr != begin + length)
+            throw std::invalid_argument("Invalid date: " + std::string(text));
+        return value;
+    };
+
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-')
+        throw std::invalid_argument("Invalid date (expected YYYY-MM-DD): " + std::string(text));
+    CivilDate date{number(0, 4), number(5, 2), number(8, 2)};
+    if (date.month < 1 || date.month > 12 || date.day < 1 || fromDays(date.toDays()) != date)
+        throw std::invalid_argument("Invalid date: " + std::string(text));
+    return date;
+}
+
+std::string CivilDate::toString() const {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+    return buffer;
+}
+
+bool CivilDate::operator==(const CivilDate& other) const {
+    return year == other.year && month == other.month && day == other.day;
+}
+
+bool CivilDate::operator!=(const CivilDate& other) const {
+    return !(*this == other);
+}
+
+StudyCalendar::StudyCalendar(int weekdayHours, int weekendHours) {
+    weekly.fill(weekdayHours);
+    weekly[0] = weekendHours; // Sunday
+    weekly[6] = weekendHours; // Saturday
+}
+
+namespace {
+    // "HH:MM" as minutes after midnight
+    int parseClock(const std::string& text) {
+        int hours = -1, minutes = -1;
+        if (text.size() == 5 && text[2] == ':') {
+            std::from_chars(text.data(), text.data() + 2, hours);
+            std::from_chars(text.data() + 3, text.data() + 5, minutes);
+        }
+        if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59)
+            throw std::invalid_argument("Invalid time of day (expected HH:MM): " + text);
+        return hours * 60 + minutes;
+    }
+}
+
+StudyCalendar StudyCalendar::fromJson(const std::string& text) {
+    static const char* const dayNames[7] = {"sunday", "monday", "tuesday", "wednesday", "thursday", "friday", "saturday"};
+
+    StudyCalendar calendar;
+    try {
+        json config = json::parse(text);
+        if (!config.is_object())
+            throw std::invalid_argument("Study calendar: expected a JSON object");
+
+        if (config.contains("weekly")) {
+            const json& weeklyHours = config.at("weekly");
+            for (const auto& item : weeklyHours.items()) {
+                auto name = std::find(std::begin(dayNames), std::end(dayNames), item.key());
+                if (name == std::end(dayNames))
+                    throw std::invalid_argument("Study calendar: unknown weekday \"" + item.key() + "\"");
+                calendar.setWeeklyHours(static_cast<int>(name - std::begin(dayNames)), item.value().get<int>());
+            }
+        }
+        if (config.contains("holidays")) {
+            for (const auto& date : config.at("holidays"))
+                calendar.addHoliday(CivilDate::parse(date.get<std::string>()));
+        }
+        if (config.contains("exceptions")) {
+            for (const auto& item : config.at("exceptions").items())
+                calendar.setException(CivilDate::parse(item.key()), item.value().get<int>());
+        }
+        if (config.contains("slot_minutes"))
+            calendar.setSlotMinutes(config.at("slot_minutes").get<int>());
+        if (config.contains("window")) {
+            const json& window = config.at("window");
+            int start = parseClock(window.at("start").get<std::string>());
+            int end = parseClock(window.at("end").get<std::string>());
+            calendar.setStudyWindow(start, end > start ? end - start : end + 24 * 60 - start);
+        }
+    } catch (const json::exception& e) {
+        throw std::invalid_argument(std::string("Study calendar: ") + e.what());
+    }
+    return calendar;
+}
+
+StudyCalendar StudyCalendar::fromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open())
+        throw FileException("Could not open calendar file " + filename);
+    return fromJson(std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()));
+}
+
+void StudyCalendar::setWeeklyHours(int weekday, int hours) {
+    weekly.at(static_cast<std::size_t>(weekday)) = hours;
+}
+
+void StudyCalendar::addHoliday(const CivilDate& date) {
+    holidays[date.toDays()] = 0;
+}
+
+void StudyCalendar::setException(const CivilDate& date, int hours) {
+    exceptions[date.toDays()] = hours;
+}
+
+void StudyCalendar::setSlotMinutes(int minutes) {
+    TimeGrid(0, minutes, windowStart, windowMinutes); // Validates the combination
+    slotMinutes = minutes;
+}
+
+void StudyCalendar::setStudyWindow(int startMinute, int minutes) {
+    TimeGrid(0, slotMinutes, startMinute, minutes);
+    windowStart = startMinute;
+    windowMinutes = minutes;
+}
+
+void StudyCalendar::setBusyTimes(BusyCalendar busy) {
+    busyTimes = std::move(busy);
+}
+
+int StudyCalendar::hoursOn(const CivilDate& date) const {
+    const long long days = date.toDays();
+    if (auto exception = exceptions.find(days); exception != exceptions.end())
+        return exception->second;
+    if (holidays.count(days))
+        return 0;
+    return weekly[static_cast<std::size_t>(date.weekday())];
+}
+
+std::vector<int> StudyCalendar::capacity(const CivilDate& base, int days) const {
+    days = std::clamp(days, 0, MaxHorizonDays);
+    std::vector<int> hours(static_cast<std::size_t>(days));
+
+    // Walk the weekly pattern, then apply holidays and exceptions falling inside the horizon
+    const long long first = base.toDays() + 1;
+    int weekday = base.plusDays(1).weekday();
+    for (int i = 0; i < days; ++i) {
+        hours[static_cast<std::size_t>(i)] = weekly[static_cast<std::size_t>(weekday)];
+        weekday = weekday == 6 ? 0 : weekday + 1;
+    }
+    for (auto it = holidays.lower_bound(first); it != holidays.end() && it->first < first + days; ++it)
+        hours[static_cast<std::size_t>(it->first - first)] = 0;
+    for (auto it = exceptions.lower_bound(first); it != exceptions.end() && it->first < first + days; ++it)
+        hours[static_cast<std::size_t>(it->first - first)] = it->second;
+    return hours;
+}
+
+TimeGrid StudyCalendar::timeGrid(const CivilDate& base, int days) const {
+    TimeGrid grid(std::clamp(days, 0, MaxHorizonDays), slotMinutes, windowStart, windowMinutes);
+    busyTimes.block(grid, base);
+    return grid;
+}
+
+std::vector<int> StudyCalendar::freeCapacity(const CivilDate& base, int days, const TimeGrid& grid) const {
+    std::vector<int> hours = capacity(base, days);
+    for (std::size_t i = 0; i < hours.size(); ++i)
+        hours[i] = std::min(hours[i], grid.freeHours(static_cast<int>(i) + 1));
+    return hours;
+}
+
+std::vector<int> StudyCalendar::freeCapacity(const CivilDate& base, int days) const {
+    return freeCapacity(base, days, timeGrid(base, days));
+}
@@ -0,0 +1,60 @@
+#include "../include/subjecttable.hpp"
+#include <mutex>
+#include <stdexcept>
+
+SubjectTable::~SubjectTable() {
+    for (auto& chunk : chunks)
+        delete[] chunk.load(std::memory_order_relaxed);
+}
+
+SubjectTable& SubjectTable::global() {
+    static SubjectTable table;
+    return table;
+}
+
+SubjectId SubjectTable::intern(std::string_view subject) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = ids.find(subject);
+        if (it != ids.end())
+            return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(subject); // Another thread may have added it meanwhile
+    if (it != ids.end())
+        return it->second;
+
+    const std::size_t id = published.load(std::memory_order_relaxed);
+    if (id >= MaxSubjects)
+        throw std::length_error("Too many distinct subjects (at most " + std::to_string(MaxSubjects) + ")");
+
+    std::string* chunk = chunks[id / ChunkSize].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new std::string[ChunkSize];
+        chunks[id / ChunkSize].store(chunk, std::memory_order_relaxed);
+    }
+    std::string& name = chunk[id % ChunkSize];
+    name.assign(subject.data(), subject.size());
+    ids.emplace(name, static_cast<SubjectId>(id));
+
+    // Readers that see the new count also see the chunk and the finished name
+    published.store(id + 1, std::memory_order_release);
+    return static_cast<SubjectId>(id);
+}
+
+SubjectId SubjectTable::find(std::string_view subject) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(subject);
+    return it != ids.end() ? it->second : InvalidId;
+}
+
+const std::string& SubjectTable::name(SubjectId id) const {
+    if (id >= published.load(std::memory_order_acquire))
+        throw std::out_of_range("Unknown subject id " + std::to_string(id));
+    return chunks[id / ChunkSize].load(std::memory_order_relaxed)[id % ChunkSize];
+}
+
+std::size_t SubjectTable::size() const {
+    return published.load(std::memory_order_acquire);
+}
@@ -0,0 +1,95 @@
+#include "../include/timegrid.hpp"
+#include "../include/bitops.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+TimeGrid::TimeGrid(int days, int slotMinutes, int windowStart, int windowMinutes)
+    : dayCount(std::max(0, days)), slotLength(slotMinutes), startMinute(windowStart) {
+    if (slotMinutes <= 0 || 60 % slotMinutes != 0)
+        throw std::invalid_argument("Slot length must divide an hour: " + std::to_string(slotMinutes) + " minutes");
+    if (windowStart < 0 || windowStart >= 24 * 60 || windowMinutes <= 0 || windowMinutes > 24 * 60 || windowMinutes % slotMinutes != 0)
+        throw std::invalid_argument("Invalid study window");
+
+    daySlots = windowMinutes / slotMinutes;
+    wordsPerDay = (daySlots + 63) / 64;
+    words.assign(static_cast<std::size_t>(dayCount) * static_cast<std::size_t>(wordsPerDay), ~std::uint64_t(0));
+
+    // Clear the bits past the window in each day's last word
+    if (daySlots % 64 != 0) {
+        const std::uint64_t lastWord = (std::uint64_t(1) << (daySlots % 64)) - 1;
+        for (int day = 0; day < dayCount; ++day)
+            words[static_cast<std::size_t>(day * wordsPerDay + wordsPerDay - 1)] = lastWord;
+    }
+}
+
+bool TimeGrid::isFree(int day, int slot) const {
+    if (day < 1 || day > dayCount || slot < 0 || slot >= daySlots)
+        return false;
+    const std::uint64_t word = words[static_cast<std::size_t>((day - 1) * wordsPerDay + slot / 64)];
+    return (word >> (slot % 64)) & 1;
+}
+
+void TimeGrid::block(int day, int firstSlot, int count) {
+    if (day < 1 || day > dayCount)
+        return;
+    int begin = std::max(firstSlot, 0);
+    int end = static_cast<int>(std::min<long long>(static_cast<long long>(firstSlot) + count, daySlots));
+    std::uint64_t* dayWords = words.data() + static_cast<std::size_t>((day - 1) * wordsPerDay);
+
+    // Whole words at a time, masking the partial ones at either end
+    while (begin < end) {
+        const int bit = begin % 64;
+        const int span = std::min(64 - bit, end - begin);
+        const std::uint64_t mask = span == 64 ? ~std::uint64_t(0) : ((std::uint64_t(1) << span) - 1) << bit;
+        dayWords[begin / 64] &= ~mask;
+        begin += span;
+    }
+}
+
+int TimeGrid::freeSlots(int day) const {
+    if (day < 1 || day > dayCount)
+        return 0;
+    const std::uint64_t* dayWords = words.data() + static_cast<std::size_t>((day - 1) * wordsPerDay);
+    int count = 0;
+    for (int i = 0; i < wordsPerDay; ++i)
+        count += BitOps::popCount(dayWords[i]);
+    return count;
+}
+
+int TimeGrid::scan(int day, int fromSlot, bool busy) const {
+    if (day < 1 || day > dayCount || fromSlot >= daySlots)
+        return daySlots;
+    fromSlot = std::max(fromSlot, 0);
+    const std::uint64_t* dayWords = words.data() + static_cast<std::size_t>((day - 1) * wordsPerDay);
+
+    for (int index = fromSlot / 64; index < wordsPerDay; ++index) {
+        std::uint64_t word = busy ? ~dayWords[index] : dayWords[index];
+        if (index == fromSlot / 64)
+            word &= ~std::uint64_t(0) << (fromSlot % 64); // Ignore slots before the start
+        if (word != 0)
+            return std::min(index * 64 + BitOps::countTrailingZeros(word), daySlots);
+    }
+    return daySlots;
+}
+
+int TimeGrid::nextFree(int day, int fromSlot) const {
+    return scan(day, fromSlot, false);
+}
+
+int TimeGrid::nextBusy(int day, int fromSlot) const {
+    return scan(day, fromSlot, true);
+}
+
+std::vector<SlotRun> TimeGrid::take(int day, int count) {
+    std::vector<SlotRun> runs;
+    int slot = nextFree(day, 0);
+    while (count > 0 && slot < daySlots) {
+        const int length = std::min(nextBusy(day, slot) - slot, count);
+        runs.push_back({day, slot, length});
+        block(day, slot, length);
+        count -= length;
+        slot = nextFree(day, slot + length);
+    }
+    return runs;
+}
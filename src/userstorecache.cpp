@@ -0,0 +1,120 @@
+#include "../include/userstorecache.hpp"
+#include "../include/planner.hpp"
+#include "../include/arena.hpp"
+#include <algorithm>
+#include <filesystem>
+
+UserStoreCache::UserStoreCache(std::size_t byteBudget, std::string dataDirectory)
+    : budget(byteBudget), dataDirectory(std::move(dataDirectory)) {}
+
+UserStoreCache::~UserStoreCache() {
+    flush();
+}
+
+std::string UserStoreCache::userFile(const std::string& user) const {
+    return dataDirectory + "/" + user + ".json";
+}
+
+AssignmentStore& UserStoreCache::get(const std::string& user) {
+    auto found = lookup.find(user);
+    if (found != lookup.end()) {
+        ++counters.hits;
+        entries.splice(entries.begin(), entries, found->second);
+        return entries.front().store;
+    }
+
+    ++counters.misses;
+    std::vector<AssignmentStore::AssignmentPtr> assignments;
+    // A missing file is a new user; a file that fails to load throws before anything is cached,
+    // so an empty store is never written over it
+    if (std::filesystem::exists(userFile(user)))
+        assignments = Planner::loadExistingFile(userFile(user));
+    AssignmentArena::moveToHeap(assignments); // Cached stores are edited for a long time; don't pin the load arena
+
+    entries.push_front(Entry{user, AssignmentStore(std::move(assignments)), 0, false, 0, {}});
+    Entry& entry = entries.front();
+    lookup.emplace(user, entries.begin());
+    entry.bytes = entry.store.memoryUsage();
+    usedBytes += entry.bytes;
+
+    enforceBudget();
+    return entry.store;
+}
+
+void UserStoreCache::markDirty(const std::string& user) {
+    auto found = lookup.find(user);
+    if (found == lookup.end())
+        return;
+
+    Entry& entry = *found->second;
+    if (!entry.dirty)
+        entry.since = std::chrono::steady_clock::now();
+    entry.dirty = true;
+    ++entry.changes;
+    usedBytes -= entry.bytes;
+    entry.bytes = entry.store.memoryUsage();
+    usedBytes += entry.bytes;
+
+    entries.splice(entries.begin(), entries, found->second);
+    if (entry.changes >= writeBackChanges)
+        save(entry);
+    enforceBudget();
+}
+
+void UserStoreCache::flush() {
+    for (auto& entry : entries) {
+        if (entry.dirty)
+            save(entry);
+    }
+}
+
+void UserStoreCache::setWriteBack(std::size_t maxChanges, std::chrono::milliseconds maxDelay) {
+    writeBackChanges = std::max<std::size_t>(maxChanges, 1);
+    writeBackDelay = maxDelay;
+}
+
+void UserStoreCache::flushExpired() {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto& entry : entries) {
+        if (entry.dirty && now - entry.since >= writeBackDelay)
+            save(entry);
+    }
+}
+
+bool UserStoreCache::save(Entry& entry) {
+    if (!Planner::saveToFile(userFile(entry.user), entry.store.all())) {
+        ++counters.failedSaves;
+        entry.since = std::chrono::steady_clock::now(); // Retry after another write-back delay
+        return false;
+    }
+    entry.dirty = false;
+    entry.changes = 0;
+    ++counters.saves;
+    return true;
+}
+
+void UserStoreCache::enforceBudget() {
+    // Walk from the least recently used end, skipping stores whose edits could not be saved
+    auto victim = entries.end();
+    while (usedBytes > budget && entries.size() > 1 && --victim != entries.begin()) {
+        if (victim->dirty && !save(*victim))
+            continue;
+
+        usedBytes -= victim->bytes;
+        lookup.erase(victim->user);
+        victim = entries.erase(victim);
+        ++counters.evictions;
+    }
+}
+
+std::size_t UserStoreCache::size() const { return entries.size(); }
+std::size_t UserStoreCache::bytesUsed() const { return usedBytes; }
+std::size_t UserStoreCache::byteBudget() const { return budget; }
+bool UserStoreCache::contains(const std::string& user) const { return lookup.count(user) != 0; }
+
+bool UserStoreCache::isDirty(const std::string& user) const {
+    auto found = lookup.find(user);
+    return found != lookup.end() && found->second->dirty;
+}
+
+const UserStoreCache::Stats& UserStoreCache::stats() const { return counters; }
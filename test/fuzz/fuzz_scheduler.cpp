@@ -0,0 +1,54 @@
+// libFuzzer target comparing the optimized scheduler engine with the reference scheduler.
+//
+// With Clang:  cmake -DBUILD_FUZZERS=ON -DCMAKE_CXX_COMPILER=clang++ ..
+//              ./fuzz_scheduler corpus/
+// Other compilers build a standalone driver that runs random inputs, or replays the files given as arguments.
+
+#include "../scheduler_differential.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    std::string diff = SchedulerDifferential::compare(SchedulerDifferential::decode(data, size));
+    if (!diff.empty()) {
+        std::cerr << "Scheduler mismatch:\n" << diff;
+        std::abort();
+    }
+    return 0;
+}
+
+#ifdef SCHEDULER_FUZZ_STANDALONE
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv) {
+    // Replay mode: run each file given on the command line
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            std::ifstream file(argv[i], std::ios::binary);
+            std::vector<std::uint8_t> input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            LLVMFuzzerTestOneInput(input.data(), input.size());
+        }
+        return 0;
+    }
+
+    // Randomized mode
+    const char* iterationsEnv = std::getenv("FUZZ_ITERATIONS");
+    long iterations = iterationsEnv ? std::atol(iterationsEnv) : 10000;
+    std::mt19937 rng(std::random_device{}());
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<std::uint8_t> input;
+    for (long n = 0; n < iterations; ++n) {
+        input.resize(3 + SchedulerDifferential::kBytesPerAssignment * 48);
+        for (auto& b : input)
+            b = static_cast<std::uint8_t>(byte(rng));
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+    std::cout << "Compared " << iterations << " random cases.\n";
+    return 0;
+}
+#endif
@@ -0,0 +1,426 @@
+#include "gtest/gtest.h"
+#include "../include/planner.hpp"
+#include "../include/scheduleengine.hpp"
+#include "../include/assignment.hpp"
+#include "../include/assignmentparser.hpp"
+#include "../include/busycalendar.hpp"
+#include "../include/json.hpp"
+#include "../include/mappedassignmentstore.hpp"
+#include "../include/ndjsonimport.hpp"
+#include "../include/schedulesink.hpp"
+#include "../include/studycalendar.hpp"
+#include "../include/timegrid.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Timed scenario tests guarding against throughput regressions.
+//
+// Each scenario runs a fixed synthetic workload through the full
+// load -> schedule -> ICS -> save pipeline and compares its throughput
+// (assignments per second) against the baseline recorded on this machine.
+// A scenario fails when it drops below `tolerance * baseline`, or has no baseline at all.
+//
+// Record or refresh the baselines with:
+//     perfTests --update-baseline
+// or, from the build directory:
+//     cmake --build . --target update_perf_baseline
+
+#ifndef PERF_BASELINE_FILE
+#define PERF_BASELINE_FILE "perf_baseline.txt"
+#endif
+
+namespace {
+
+std::string baselinePath = PERF_BASELINE_FILE;
+bool updateBaseline = false;
+
+// Baseline throughputs and the allowed slowdown factor
+struct Baseline {
+    double tolerance = 0.5;     // As recorded in the file
+    double gateTolerance = 0.5; // Applied by this run, after any PERF_TOLERANCE override
+    std::map<std::string, double> throughput;
+};
+
+Baseline baseline;
+std::map<std::string, double> measured;
+
+Baseline readBaseline(const std::string& path) {
+    Baseline result;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream fields(line);
+        std::string key;
+        double value;
+        if (!(fields >> key >> value))
+            continue;
+
+        if (key == "tolerance")
+            result.tolerance = value;
+        else
+            result.throughput[key] = value;
+    }
+
+    // Allow CI to loosen or tighten the gate without editing the file; the file keeps its own value
+    result.gateTolerance = result.tolerance;
+    if (const char* env = std::getenv("PERF_TOLERANCE"))
+        result.gateTolerance = std::atof(env);
+
+    return result;
+}
+
+void writeBaseline(const std::string& path, const Baseline& data) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open baseline file " << path << " for writing.\n";
+        return;
+    }
+
+    file << "# Performance baselines for perfTests (assignments per second).\n"
+         << "# Throughputs are machine specific: regenerate them on the machine running the gate with\n"
+         << "#     cmake --build <build-dir> --target update_perf_baseline\n"
+         << "# A scenario fails when it falls below tolerance * baseline.\n"
+         << "tolerance " << data.tolerance << "\n";
+    for (const auto& entry : data.throughput)
+        file << entry.first << " " << entry.second << "\n";
+}
+
+// Discards everything written to it
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Silences std::cout while a workload runs
+class CoutSilencer {
+private:
+    NullBuffer sink;
+    std::streambuf* original;
+public:
+    CoutSilencer() : original(std::cout.rdbuf(&sink)) {}
+    ~CoutSilencer() { std::cout.rdbuf(original); }
+};
+
+// Deterministic synthetic assignment set
+std::vector<Planner::AssignmentPtr> makeWorkload(int count) {
+    std::mt19937 rng(20241203u + static_cast<unsigned>(count));
+    std::uniform_int_distribution<int> deadline(1, 30);
+    std::uniform_int_distribution<int> duration(1, 12);
+    std::uniform_int_distribution<int> weight(0, 40);
+    std::uniform_int_distribution<int> size(1, 3);
+    std::uniform_int_distribution<int> group(1, 4);
+
+    std::vector<Planner::AssignmentPtr> assignments;
+    assignments.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        int groupSize = group(rng);
+        assignments.push_back(std::make_shared<Assignment>(
+            "Subject " + std::to_string(i % 12), "Assignment " + std::to_string(i),
+            deadline(rng), duration(rng), static_cast<float>(weight(rng)), size(rng),
+            groupSize > 1, groupSize));
+    }
+    return assignments;
+}
+
+// The synthetic workload as NDJSON import lines spread over `users` users
+std::string makeNdjsonWorkload(int count, int users) {
+    CoutSilencer silence;
+    std::string text;
+    int line = 0;
+    for (const auto& assignment : makeWorkload(count)) {
+        text += "{\"user\":\"user" + std::to_string(line++ % users) + "\",\"subject\":\"" + assignment->getSubject() +
+                "\",\"name\":\"" + assignment->getName() + "\",\"deadline\":" + std::to_string(assignment->getDeadline()) +
+                ",\"duration\":" + std::to_string(assignment->getDuration()) +
+                ",\"weight\":" + std::to_string(static_cast<int>(assignment->getWeight())) +
+                ",\"size\":" + std::to_string(assignment->getSize()) +
+                ",\"group_work\":" + (assignment->isGroupWork() ? "true" : "false") +
+                ",\"group_size\":" + std::to_string(assignment->getGroupSize()) + "}\n";
+    }
+    return text;
+}
+
+// Runs load -> schedule -> ICS -> save on `count` assignments and returns the best throughput
+double runPipeline(int count) {
+    const std::string userName = "perf_user_" + std::to_string(count);
+    const std::string inputFile = "Data/" + userName + ".json";
+    const std::string outputFile = "Data/" + userName + "_saved.json";
+    const std::string icsFile = "Data/" + userName + "_schedule.ics";
+
+    std::filesystem::create_directory("Data");
+    {
+        CoutSilencer silence;
+        Planner::saveToFile(inputFile, makeWorkload(count));
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto budget = std::chrono::milliseconds(300);
+    const int minRepetitions = 3;
+
+    double best = 0.0;
+    auto started = Clock::now();
+    for (int rep = 0; rep < minRepetitions || Clock::now() - started < budget; ++rep) {
+        CoutSilencer silence;
+        auto begin = Clock::now();
+
+        auto assignments = Planner::loadFromFile(inputFile);
+        Planner::scheduler(assignments, 3, 5, userName);
+        Planner::saveToFile(outputFile, assignments);
+
+        std::chrono::duration<double> elapsed = Clock::now() - begin;
+        double throughput = count / elapsed.count();
+        if (throughput > best)
+            best = throughput;
+    }
+
+    std::remove(inputFile.c_str());
+    std::remove(outputFile.c_str());
+    std::remove(icsFile.c_str());
+    return best;
+}
+
+// Best throughput of `parse` over `count` assignments, repeated for a fixed time budget
+template <typename Parse>
+double bestParseThroughput(int count, Parse parse) {
+    using Clock = std::chrono::steady_clock;
+    const auto budget = std::chrono::milliseconds(300);
+    const int minRepetitions = 3;
+
+    double best = 0.0;
+    auto started = Clock::now();
+    for (int rep = 0; rep < minRepetitions || Clock::now() - started < budget; ++rep) {
+        auto begin = Clock::now();
+        std::size_t parsed = parse();
+        std::chrono::duration<double> elapsed = Clock::now() - begin;
+        EXPECT_EQ(parsed, static_cast<std::size_t>(count));
+
+        double throughput = count / elapsed.count();
+        if (throughput > best)
+            best = throughput;
+    }
+    return best;
+}
+
+// Records the scenario in update mode, otherwise checks it against the baseline
+void checkScenario(const std::string& scenario, double throughput) {
+    measured[scenario] = throughput;
+    if (updateBaseline)
+        return;
+
+    auto it = baseline.throughput.find(scenario);
+    if (it == baseline.throughput.end()) {
+        ADD_FAILURE() << "No baseline recorded for " << scenario << " (run perfTests --update-baseline)";
+        return;
+    }
+
+    double minimum = it->second * baseline.gateTolerance;
+    std::cout << scenario << ": " << throughput << " assignments/s (baseline " << it->second
+              << ", minimum " << minimum << ")\n";
+    EXPECT_GE(throughput, minimum) << scenario << " regressed below " << baseline.gateTolerance
+                                   << "x of its recorded baseline";
+}
+
+} // namespace
+
+// Small store, dominated by fixed per-run costs
+TEST(PerformanceGate, Pipeline_100) {
+    checkScenario("pipeline_100", runPipeline(100));
+}
+
+// Medium store
+TEST(PerformanceGate, Pipeline_400) {
+    checkScenario("pipeline_400", runPipeline(400));
+}
+
+// Large store, where quadratic behaviour shows up first
+TEST(PerformanceGate, Pipeline_1600) {
+    checkScenario("pipeline_1600", runPipeline(1600));
+}
+
+// Assignment file parsing: schema-specialized fast path against the general JSON parser
+TEST(PerformanceGate, Parse_4000) {
+    const int count = 4000;
+    const std::string filename = "Data/perf_parse.json";
+    std::filesystem::create_directory("Data");
+    {
+        CoutSilencer silence;
+        Planner::saveToFile(filename, makeWorkload(count));
+    }
+    std::ifstream file(filename, std::ios::binary);
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(filename.c_str());
+
+    double fast = bestParseThroughput(count, [&] {
+        std::size_t records = 0;
+        bool ok = AssignmentParser::parseArray(text, [&](const AssignmentParser::Record&) { ++records; });
+        return ok ? records : 0;
+    });
+    double general = bestParseThroughput(count, [&] {
+        return nlohmann::json::parse(text).size();
+    });
+
+    std::cout << "parse_4000: fast " << fast << " assignments/s, nlohmann " << general
+              << " assignments/s (" << fast / general << "x)\n";
+    checkScenario("parse_4000", fast);
+}
+
+// Read-only batch scheduling: mapped zero-copy load against loadFromFile, both followed by scheduling
+TEST(PerformanceGate, MappedSchedule_4000) {
+    const int count = 4000;
+    const std::string filename = "Data/perf_mapped.json";
+    std::filesystem::create_directory("Data");
+    {
+        CoutSilencer silence;
+        Planner::saveToFile(filename, makeWorkload(count));
+    }
+
+    double mapped = bestParseThroughput(count, [&] {
+        MappedAssignmentStore store(filename);
+        Planner::computeSchedule(store.all(), 3, 5);
+        return store.size();
+    });
+    double copied = bestParseThroughput(count, [&] {
+        CoutSilencer silence;
+        auto assignments = Planner::loadFromFile(filename);
+        Planner::computeSchedule(assignments, 3, 5);
+        return assignments.size();
+    });
+    std::remove(filename.c_str());
+
+    std::cout << "mapped_schedule_4000: mapped " << mapped << " assignments/s, loadFromFile " << copied
+              << " assignments/s (" << mapped / copied << "x)\n";
+    checkScenario("mapped_schedule_4000", mapped);
+}
+
+// Scheduling alone on a large store with a long horizon, where kinetic rescoring skips most days
+TEST(PerformanceGate, ScheduleHorizon_5000) {
+    const int count = 5000;
+    std::vector<Planner::AssignmentPtr> assignments;
+    {
+        CoutSilencer silence;
+        std::mt19937 rng(5000);
+        std::uniform_int_distribution<int> deadline(5, 150);
+        std::uniform_int_distribution<int> duration(1, 6);
+        for (int i = 0; i < count; ++i)
+            assignments.push_back(std::make_shared<Assignment>("Subject", "Assignment " + std::to_string(i), deadline(rng),
+                                                               duration(rng), static_cast<float>(i % 30), i % 3 + 1, false, 1));
+    }
+
+    double throughput = bestParseThroughput(count, [&] {
+        Planner::computeSchedule(assignments, 3, 5);
+        return assignments.size();
+    });
+    {
+        CoutSilencer silence;
+        assignments.clear();
+    }
+    checkScenario("schedule_horizon_5000", throughput);
+}
+
+// Parallel NDJSON import parsing for many users
+TEST(PerformanceGate, NdjsonImport_20000) {
+    const int count = 20000;
+    const std::string text = makeNdjsonWorkload(count, 50);
+
+    double throughput = bestParseThroughput(count, [&] {
+        CoutSilencer silence; // Imported assignments are released inside the timed region
+        return NdjsonImport::parse(text).assignments;
+    });
+    checkScenario("ndjson_import_20000", throughput);
+}
+
+// Busy-time import of a large calendar into a year of 15-minute study slots (events per second)
+TEST(PerformanceGate, BusyCalendar_20000) {
+    const int count = 20000;
+    std::string text = "BEGIN:VCALENDAR\r\nVERSION:2.0\r\n";
+    const CivilDate base{2026, 1, 1};
+    for (int i = 0; i < count; ++i) {
+        CivilDate date = base.plusDays(i % 400 - 30);
+        char event[256];
+        std::snprintf(event, sizeof(event),
+                      "BEGIN:VEVENT\r\nUID:event-%d@example.com\r\nSUMMARY:Appointment %d\r\n"
+                      "DTSTART:%04d%02d%02dT%02d%02d00\r\nDURATION:PT%dM\r\n%sEND:VEVENT\r\n",
+                      i, i, date.year, date.month, date.day, 8 + i % 14, (i % 4) * 15, 30 + i % 5 * 15,
+                      i % 10 == 0 ? "RRULE:FREQ=WEEKLY;COUNT=12\r\n" : "");
+        text += event;
+    }
+    text += "END:VCALENDAR\r\n";
+
+    double throughput = bestParseThroughput(count, [&] {
+        BusyCalendar busy = BusyCalendar::parse(text, 0);
+        TimeGrid grid(365, 15, 18 * 60, 6 * 60);
+        busy.block(grid, base);
+        return busy.events().size();
+    });
+    checkScenario("busy_calendar_20000", throughput);
+}
+
+// Scheduling and slot placement into a null sink, isolating compute from export cost
+TEST(PerformanceGate, ScheduleNullSink_2000) {
+    const int count = 2000;
+    std::vector<Planner::AssignmentPtr> assignments;
+    {
+        CoutSilencer silence;
+        std::mt19937 rng(2000);
+        std::uniform_int_distribution<int> deadline(5, 120);
+        std::uniform_int_distribution<int> duration(1, 6);
+        for (int i = 0; i < count; ++i)
+            assignments.push_back(std::make_shared<Assignment>("Subject", "Assignment " + std::to_string(i), deadline(rng),
+                                                               duration(rng), static_cast<float>(i % 30), i % 3 + 1, false, 1));
+    }
+    StudyCalendar calendar(3, 5);
+    calendar.setSlotMinutes(15);
+
+    std::size_t sessions = 0;
+    double throughput = bestParseThroughput(count, [&] {
+        NullScheduleSink sink;
+        Planner::emitSchedule(assignments, calendar, CivilDate{2026, 1, 1}, sink);
+        sessions = sink.sessions();
+        return assignments.size();
+    });
+    EXPECT_GT(sessions, 0u);
+    {
+        CoutSilencer silence;
+        assignments.clear();
+    }
+    checkScenario("schedule_null_sink_2000", throughput);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--update-baseline")
+            updateBaseline = true;
+        else if (arg.rfind("--baseline=", 0) == 0)
+            baselinePath = arg.substr(std::string("--baseline=").size());
+    }
+
+    baseline = readBaseline(baselinePath);
+    int result = RUN_ALL_TESTS();
+
+    if (updateBaseline && result == 0) {
+        for (const auto& entry : measured)
+            baseline.throughput[entry.first] = entry.second;
+        writeBaseline(baselinePath, baseline);
+        std::cout << "Baseline written to " << baselinePath << "\n";
+    }
+
+    return result;
+}
@@ -0,0 +1,108 @@
+#ifndef SCHEDULER_DIFFERENTIAL_HPP
+#define SCHEDULER_DIFFERENTIAL_HPP
+
+// Differential check between Planner::referenceSchedule and Planner::computeSchedule.
+// Shared by the randomized unit test and the libFuzzer target in test/fuzz.
+
+#include "../include/scheduleengine.hpp"
+#include "../include/assignment.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace SchedulerDifferential {
+    // Assignment set and hour settings decoded from fuzzer bytes
+    struct Case {
+        std::vector<std::shared_ptr<Assignment>> assignments;
+        int weekdayStudyHours = 0;
+        int weekendStudyHours = 0;
+    };
+
+    // Bytes consumed per assignment after the three header bytes
+    constexpr std::size_t kBytesPerAssignment = 6;
+
+    // Decode arbitrary bytes into a bounded scheduling case
+    inline Case decode(const std::uint8_t* data, std::size_t size) {
+        Case result;
+        if (size < 3)
+            return result;
+
+        result.weekdayStudyHours = data[0] % 10 - 1; // -1..8, including the degenerate cases
+        result.weekendStudyHours = data[1] % 14 - 1; // -1..12
+        std::size_t count = data[2] % 48;
+
+        const std::uint8_t* cursor = data + 3;
+        std::size_t left = size - 3;
+        for (std::size_t i = 0; i < count && left >= kBytesPerAssignment; ++i) {
+            int deadline = cursor[0] % 45 - 2;         // Already overdue through six weeks
+            int duration = cursor[1] % 40;             // Zero-hour tasks still take a slot
+            float weight = (cursor[2] % 161) / 4.0f;   // 0..40 in quarter steps, hits every threshold
+            int size = cursor[3] % 5;                  // Includes out-of-range sizes
+            int groupSize = 1 + cursor[4] % 4;
+            bool groupWork = groupSize > 1 || (cursor[5] & 1);
+
+            result.assignments.push_back(std::make_shared<Assignment>(
+                "Subject " + std::to_string(cursor[5] % 7), "Task " + std::to_string(i),
+                deadline, duration, weight, size, groupWork, groupSize));
+
+            cursor += kBytesPerAssignment;
+            left -= kBytesPerAssignment;
+        }
+        return result;
+    }
+
+    // Describe the first difference between two schedules, or return an empty string
+    inline std::string describe(const Planner::ScheduleResult& reference, const Planner::ScheduleResult& optimized) {
+        std::ostringstream diff;
+        if (optimized.days != reference.days)
+            diff << "days: reference " << reference.days << ", optimized " << optimized.days << "\n";
+
+        std::size_t slots = std::min(optimized.slots.size(), reference.slots.size());
+        for (std::size_t i = 0; i < slots; ++i) {
+            const auto& a = reference.slots[i];
+            const auto& b = optimized.slots[i];
+            if (a.day != b.day || a.hour != b.hour || a.assignment != b.assignment) {
+                diff << "slot " << i << ": reference (day " << a.day << ", hour " << a.hour << ", task " << a.assignment
+                     << "), optimized (day " << b.day << ", hour " << b.hour << ", task " << b.assignment << ")\n";
+                break;
+            }
+        }
+        if (optimized.slots.size() != reference.slots.size())
+            diff << "slot count: reference " << reference.slots.size() << ", optimized " << optimized.slots.size() << "\n";
+
+        std::size_t missed = std::min(optimized.missed.size(), reference.missed.size());
+        for (std::size_t i = 0; i < missed; ++i) {
+            const auto& a = reference.missed[i];
+            const auto& b = optimized.missed[i];
+            if (a.day != b.day || a.assignment != b.assignment) {
+                diff << "missed " << i << ": reference (day " << a.day << ", task " << a.assignment
+                     << "), optimized (day " << b.day << ", task " << b.assignment << ")\n";
+                break;
+            }
+        }
+        if (optimized.missed.size() != reference.missed.size())
+            diff << "missed count: reference " << reference.missed.size() << ", optimized " << optimized.missed.size() << "\n";
+
+        return diff.str();
+    }
+
+    // Run both schedulers and describe the first difference, or return an empty string
+    inline std::string compare(const Case& input) {
+        // The engine leaves its input untouched, so the reference can consume the same objects afterwards
+        Planner::ScheduleResult optimized = Planner::computeSchedule(input.assignments, input.weekdayStudyHours, input.weekendStudyHours);
+        Planner::ScheduleResult reference = Planner::referenceSchedule(input.assignments, input.weekdayStudyHours, input.weekendStudyHours);
+        return describe(reference, optimized);
+    }
+
+    // Same comparison with per-day study hours
+    inline std::string compare(const Case& input, const Planner::DayCapacity& capacity) {
+        Planner::ScheduleResult optimized = Planner::computeSchedule(input.assignments, capacity);
+        Planner::ScheduleResult reference = Planner::referenceSchedule(input.assignments, capacity);
+        return describe(reference, optimized);
+    }
+}
+
+#endif // SCHEDULER_DIFFERENTIAL_HPP
@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include "../include/arena.hpp"
+#include "../include/scheduleengine.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Test that assignments made from an arena keep it alive after the arena handle is gone
+TEST(ArenaTest, AssignmentsOutliveArenaHandle) {
+    std::vector<std::shared_ptr<Assignment>> assignments;
+    {
+        AssignmentArena arena(256);
+        for (int i = 0; i < 50; ++i)
+            assignments.push_back(arena.make("Math", "Homework " + std::to_string(i), i + 1, 2, 5.0f, 2, false, 1));
+    }
+
+    ASSERT_EQ(assignments.size(), 50);
+    EXPECT_EQ(assignments[49]->getName(), "Homework 49");
+    EXPECT_EQ(assignments[0]->getSubject(), "Math");
+}
+
+// Test that moving assignments to the heap releases the arena and keeps their values
+TEST(ArenaTest, MoveToHeapReleasesArena) {
+    AssignmentArena arena(256);
+    std::vector<std::shared_ptr<Assignment>> assignments;
+    for (int i = 0; i < 5; ++i) {
+        assignments.push_back(arena.make("Math", "Homework " + std::to_string(i), i + 1, 2, 5.0f, 2, false, 1));
+        assignments.back()->setId(i + 10);
+    }
+    EXPECT_TRUE(arena.pinned());
+
+    AssignmentArena::moveToHeap(assignments);
+    EXPECT_FALSE(arena.pinned());
+    EXPECT_EQ(assignments[4]->getName(), "Homework 4");
+    EXPECT_EQ(assignments[4]->getId(), 14u);
+    EXPECT_EQ(assignments[4]->getSubject(), "Math");
+}
+
+// Test that the scheduler's scratch block grows to the peak and is reused by later runs
+TEST(ArenaTest, ScratchBlockGrowsToPeak) {
+    std::vector<std::shared_ptr<Assignment>> assignments;
+    for (int i = 0; i < 2000; ++i)
+        assignments.push_back(std::make_shared<Assignment>("S", "A" + std::to_string(i), i % 20 + 1, 3, 1.0f, 1, false, 1));
+
+    Planner::computeSchedule(assignments, 4, 6);
+    std::size_t grown = ScratchArena::threadBlockSize();
+    EXPECT_GE(grown, 2000 * (4 * sizeof(int) + sizeof(float) + 2 * sizeof(std::size_t)));
+
+    Planner::computeSchedule(assignments, 4, 6);
+    EXPECT_EQ(ScratchArena::threadBlockSize(), grown); // The second run fits in the block
+}
+
+// Test that a nested arena on the same thread does not share the outer arena's block
+TEST(ArenaTest, NestedScratchArenas) {
+    ScratchArena outer;
+    std::pmr::vector<int> a(100, 1, outer.resource());
+    {
+        ScratchArena inner;
+        std::pmr::vector<int> b(100, 2, inner.resource());
+        EXPECT_EQ(b[99], 2);
+    }
+    EXPECT_EQ(a[99], 1);
+}
@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+#include "../include/assignmentparser.hpp"
+#include "../include/planner.hpp"
+#include "../include/json.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+// Parsed records with their strings copied out of the parser's scratch space
+struct Parsed {
+    std::vector<AssignmentParser::Record> records;
+    std::vector<std::string> subjects;
+    std::vector<std::string> names;
+    bool ok = false;
+};
+
+static Parsed parseAll(const std::string& text) {
+    Parsed result;
+    result.ok = AssignmentParser::parseArray(text, [&](const AssignmentParser::Record& record) {
+        result.records.push_back(record);
+        result.subjects.emplace_back(record.subject);
+        result.names.emplace_back(record.name);
+    });
+    return result;
+}
+
+static const char* const SavedFile = R"([
+    {
+        "deadline": 5,
+        "duration": 3,
+        "group_size": 1,
+        "group_work": false,
+        "id": 7,
+        "name": "Homework 1",
+        "size": 2,
+        "subject": "Math",
+        "weight": 10.5
+    },
+    {"subject": "Art", "name": "Sketch", "deadline": 2, "duration": 1,
+     "weight": 3, "size": 1, "group_work": true, "group_size": 4}
+])";
+
+// Test parsing the format written by saveToFile, in any key order
+TEST(AssignmentParserTest, ParsesSavedFormat) {
+    Parsed parsed = parseAll(SavedFile);
+    const auto& records = parsed.records;
+
+    ASSERT_TRUE(parsed.ok);
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(parsed.subjects[0], "Math");
+    EXPECT_EQ(parsed.names[0], "Homework 1");
+    EXPECT_EQ(records[0].deadline, 5);
+    EXPECT_EQ(records[0].duration, 3);
+    EXPECT_FLOAT_EQ(records[0].weight, 10.5f);
+    EXPECT_EQ(records[0].size, 2);
+    EXPECT_FALSE(records[0].groupWork);
+    EXPECT_EQ(records[0].id, 7u);
+    EXPECT_EQ(records[1].id, 0u);
+    EXPECT_TRUE(records[1].groupWork);
+    EXPECT_EQ(records[1].groupSize, 4);
+}
+
+// Test that escaped strings are decoded, including surrogate pairs
+TEST(AssignmentParserTest, DecodesEscapes) {
+    Parsed parsed = parseAll(R"([{"subject":"S","name":"a\"b\\c\n\u00e9\ud83d\ude00","deadline":1,)"
+                            R"("duration":1,"weight":1,"size":1,"group_work":false,"group_size":1}])");
+
+    ASSERT_TRUE(parsed.ok);
+    ASSERT_EQ(parsed.names.size(), 1);
+    EXPECT_EQ(parsed.names[0], json::parse("\"a\\\"b\\\\c\\n\\u00e9\\ud83d\\ude00\"").get<std::string>());
+}
+
+// Test that anything outside the schema is rejected so the caller can fall back
+TEST(AssignmentParserTest, RejectsUnsupportedInput) {
+    const std::string fields = R"("subject":"S","name":"N","deadline":1,"duration":1,"weight":1,"size":1,"group_work":false)";
+    const std::vector<std::string> inputs = {
+        "null",
+        "[{" + fields + "}]",                                  // Missing group_size
+        "[{" + fields + R"(,"group_size":1,"extra":1}])",      // Unknown key
+        "[{" + fields + R"(,"group_size":1,"size":2}])",       // Repeated key
+        "[{" + fields + R"(,"group_size":1.5}])",              // Fractional integer
+        "[{" + fields + R"(,"group_size":1}] trailing)",
+        "[{" + fields + R"(,"group_size":1})",                 // Truncated
+    };
+
+    for (const auto& input : inputs) {
+        EXPECT_FALSE(parseAll(input).ok) << input;
+    }
+}
+
+// Test that loadFromFile still accepts files only the general parser understands
+TEST(AssignmentParserTest, LoadFallsBackToGeneralParser) {
+    const std::string filename = "parser_fallback.json";
+    {
+        std::ofstream file(filename);
+        file << R"([{"subject":"Math","name":"HW","deadline":4,"duration":2,"weight":1,)"
+             << R"("size":1,"group_work":false,"group_size":1,"notes":"kept by hand"}])";
+    }
+
+    auto assignments = Planner::loadFromFile(filename);
+    ASSERT_EQ(assignments.size(), 1);
+    EXPECT_EQ(assignments[0]->getName(), "HW");
+    EXPECT_EQ(assignments[0]->getDeadline(), 4);
+
+    std::remove(filename.c_str());
+}
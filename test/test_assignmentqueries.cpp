@@ -0,0 +1,58 @@
+#include "gtest/gtest.h"
+#include "../include/assignmentqueries.hpp"
+#include "../include/assignment.hpp"
+#include <vector>
+#include <memory>
+
+static std::shared_ptr<Assignment> createAssignment(const std::string& name, int deadline, int duration) {
+    return std::make_shared<Assignment>("Math", name, deadline, duration, 10.0f, 2, false, 1);
+}
+
+static std::vector<AssignmentQueries::AssignmentPtr> sampleAssignments() {
+    return {
+        createAssignment("A", 9, 4),
+        createAssignment("B", 2, 12),
+        createAssignment("C", 5, 1),
+        createAssignment("D", 2, 7),
+        createAssignment("E", 14, 12)
+    };
+}
+
+// Test AssignmentQueries::soonestDeadlines returns the first k in order, ties by list position
+TEST(AssignmentQueriesTest, SoonestDeadlines_TopK) {
+    auto result = AssignmentQueries::soonestDeadlines(sampleAssignments(), 3);
+
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_EQ(result[0]->getName(), "B");
+    EXPECT_EQ(result[1]->getName(), "D");
+    EXPECT_EQ(result[2]->getName(), "C");
+}
+
+// Test AssignmentQueries::soonestDeadlines with k larger than the list
+TEST(AssignmentQueriesTest, SoonestDeadlines_KExceedsSize) {
+    auto result = AssignmentQueries::soonestDeadlines(sampleAssignments(), 100);
+
+    ASSERT_EQ(result.size(), 5);
+    EXPECT_EQ(result[4]->getName(), "E");
+}
+
+// Test AssignmentQueries::longestDurations
+TEST(AssignmentQueriesTest, LongestDurations_TopK) {
+    auto result = AssignmentQueries::longestDurations(sampleAssignments(), 2);
+
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[0]->getName(), "B");
+    EXPECT_EQ(result[1]->getName(), "E");
+}
+
+// Test AssignmentQueries::dueWithin
+TEST(AssignmentQueriesTest, DueWithin) {
+    auto result = AssignmentQueries::dueWithin(sampleAssignments(), 5);
+
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_EQ(result[0]->getName(), "B");
+    EXPECT_EQ(result[1]->getName(), "D");
+    EXPECT_EQ(result[2]->getName(), "C");
+
+    EXPECT_TRUE(AssignmentQueries::dueWithin(sampleAssignments(), 1).empty());
+}
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+#include "../include/assignmentrenderer.hpp"
+#include "../include/outputbuffer.hpp"
+#include "../include/assignment.hpp"
+#include "../include/json.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// Test that OutputBuffer formats floats like an ostream does
+TEST(OutputBufferTest, FloatMatchesOstream) {
+    for (float value : {0.0f, 20.0f, 12.5f, 0.1f, 33.333333f, 1234567.0f, 1e-5f}) {
+        std::ostringstream expected;
+        expected << value;
+
+        std::ostringstream out;
+        {
+            OutputBuffer buffer(out);
+            buffer.appendFloat(value);
+        }
+        EXPECT_EQ(out.str(), expected.str());
+    }
+}
+
+// Test that OutputBuffer escapes JSON strings and only writes on flush
+TEST(OutputBufferTest, JsonStringAndFlush) {
+    std::ostringstream out;
+    OutputBuffer buffer(out);
+    buffer.appendJsonString("say \"hi\"\n\\ \x01");
+
+    EXPECT_TRUE(out.str().empty());
+    buffer.flush();
+    EXPECT_EQ(out.str(), "\"say \\\"hi\\\"\\n\\\\ \\u0001\"");
+}
+
+// Test the TSV layout
+TEST(AssignmentRendererTest, TsvLayout) {
+    Assignment assignment("Math", "Home\twork", 5, 10, 20.5f, 1, false, 1);
+
+    std::ostringstream out;
+    AssignmentRenderer renderer(out, AssignmentRenderer::Layout::Tsv);
+    renderer.text("ignored title\n");
+    renderer.row(assignment);
+    renderer.finish();
+
+    EXPECT_EQ(out.str(),
+              "id\tsubject\tname\tdeadline\tduration\tweight\tsize\tgroup_work\tgroup_size\treal_duration\tpriority\n"
+              "0\tMath\tHome work\t5\t10\t20.5\t1\tfalse\t1\t10\t0\n");
+}
+
+// Test that the NDJSON layout produces one parseable object per line
+TEST(AssignmentRendererTest, NdjsonLayout) {
+    Assignment first("Math", "Quote \"this\"", 5, 10, 20.0f, 1, false, 1);
+    Assignment second("Art", "Mural", 9, 8, 12.5f, 2, true, 4);
+
+    std::ostringstream out;
+    AssignmentRenderer renderer(out, AssignmentRenderer::Layout::Ndjson);
+    renderer.row(first);
+    renderer.row(second);
+    renderer.finish();
+
+    std::istringstream lines(out.str());
+    std::string line;
+    std::getline(lines, line);
+    auto row = nlohmann::json::parse(line);
+    EXPECT_EQ(row["name"], "Quote \"this\"");
+    EXPECT_EQ(row["deadline"], 5);
+
+    std::getline(lines, line);
+    row = nlohmann::json::parse(line);
+    EXPECT_EQ(row["subject"], "Art");
+    EXPECT_FLOAT_EQ(row["weight"].get<float>(), 12.5f);
+    EXPECT_EQ(row["real_duration"], 2);
+}
+
+// Test that the table layout pads every column and keeps fractional weights
+TEST(AssignmentRendererTest, TableLayout) {
+    Assignment assignment("Art", "Mural", 9, 8, 12.5f, 2, true, 4);
+    assignment.setId(3);
+
+    std::ostringstream out;
+    AssignmentRenderer renderer(out, AssignmentRenderer::Layout::Table);
+    renderer.row(assignment);
+    renderer.finish();
+
+    std::istringstream lines(out.str());
+    std::string header, row;
+    std::getline(lines, header);
+    std::getline(lines, row);
+    EXPECT_EQ(row.find("12.5%"), header.find("Weight"));
+    EXPECT_EQ(row.substr(0, 9), "3        ");
+}
+
+// Test layout name parsing
+TEST(AssignmentRendererTest, ParseLayout) {
+    EXPECT_EQ(AssignmentRenderer::parseLayout("table"), AssignmentRenderer::Layout::Table);
+    EXPECT_EQ(AssignmentRenderer::parseLayout("ndjson"), AssignmentRenderer::Layout::Ndjson);
+    EXPECT_THROW(AssignmentRenderer::parseLayout("xml"), std::invalid_argument);
+}
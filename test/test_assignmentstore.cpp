@@ -0,0 +1,177 @@
+#include "gtest/gtest.h"
+#include "../include/assignmentstore.hpp"
+#include "../include/displayfunctions.hpp"
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static std::shared_ptr<Assignment> createAssignment(const std::string& subject, const std::string& name, int deadline, int duration) {
+    return std::make_shared<Assignment>(subject, name, deadline, duration, 10.0f, 2, false, 1);
+}
+
+// Collect assignment names from an index in iteration order
+template <typename Index>
+static std::vector<std::string> names(const Index& index) {
+    std::vector<std::string> result;
+    for (const auto& entry : index)
+        result.push_back(entry.second->getName());
+    return result;
+}
+
+// Test that indices are built from the loaded assignments
+TEST(AssignmentStoreTest, IndicesBuiltOnConstruction) {
+    AssignmentStore store({
+        createAssignment("Math", "A", 9, 4),
+        createAssignment("Science", "B", 2, 12),
+        createAssignment("Math", "C", 5, 1)
+    });
+
+    EXPECT_EQ(store.size(), 3);
+    EXPECT_EQ(names(store.byDeadline()), (std::vector<std::string>{"B", "C", "A"}));
+    EXPECT_EQ(names(store.byDuration()), (std::vector<std::string>{"B", "A", "C"}));
+
+    const auto& math = store.bySubject("Math");
+    ASSERT_EQ(math.size(), 2);
+    EXPECT_EQ(math[0]->getName(), "A");
+    EXPECT_TRUE(store.bySubject("History").empty());
+}
+
+// Test that add and removeAt keep the list and every index in sync
+TEST(AssignmentStoreTest, AddAndRemoveUpdateIndices) {
+    AssignmentStore store;
+    store.add(createAssignment("Math", "A", 9, 4));
+    store.add(createAssignment("Math", "B", 9, 4));
+    store.add(createAssignment("Art", "C", 1, 8));
+
+    store.removeAt(0);
+
+    // The remaining assignments keep their order
+    ASSERT_EQ(store.size(), 2);
+    EXPECT_EQ(store.at(0)->getName(), "B");
+    EXPECT_EQ(store.at(1)->getName(), "C");
+    EXPECT_EQ(names(store.byDeadline()), (std::vector<std::string>{"C", "B"}));
+    EXPECT_EQ(names(store.byDuration()), (std::vector<std::string>{"C", "B"}));
+
+    const auto& math = store.bySubject("Math");
+    ASSERT_EQ(math.size(), 1);
+    EXPECT_EQ(math[0]->getName(), "B");
+
+    EXPECT_THROW(store.removeAt(5), std::out_of_range);
+}
+
+// Test that ids are assigned, kept unique and usable for lookup, update and delete
+TEST(AssignmentStoreTest, StableIds) {
+    auto loaded = createAssignment("Math", "Loaded", 4, 2);
+    loaded->setId(41);
+    auto duplicate = createAssignment("Math", "Duplicate", 4, 2);
+    duplicate->setId(41);
+
+    AssignmentStore store({loaded, duplicate});
+    AssignmentId added = store.add(createAssignment("Art", "New", 6, 3));
+
+    EXPECT_EQ(store.at(0)->getId(), 41);
+    EXPECT_NE(store.at(1)->getId(), 41);
+    EXPECT_GT(added, 41);
+    EXPECT_EQ(store.find(added)->getName(), "New");
+
+    // Update keeps the id and position but re-indexes the new values
+    EXPECT_TRUE(store.update(41, createAssignment("Math", "Loaded v2", 1, 9)));
+    EXPECT_EQ(store.at(0)->getName(), "Loaded v2");
+    EXPECT_EQ(store.at(0)->getId(), 41);
+    EXPECT_EQ(store.byDeadline().begin()->second->getName(), "Loaded v2");
+
+    EXPECT_TRUE(store.remove(41));
+    EXPECT_FALSE(store.remove(41));
+    EXPECT_EQ(store.find(41), nullptr);
+    EXPECT_EQ(store.size(), 2);
+    EXPECT_EQ(store.find(added), store.at(1));
+    EXPECT_FALSE(store.update(41, createAssignment("Math", "Gone", 1, 1)));
+}
+
+// Test that deletes keep list and posting order across compactions
+TEST(AssignmentStoreTest, RemoveKeepsOrder) {
+    AssignmentStore store;
+    std::vector<AssignmentId> ids;
+    for (int i = 0; i < 10; ++i)
+        ids.push_back(store.add(createAssignment(i % 2 ? "Art" : "Math", std::to_string(i), 9, 4)));
+
+    store.remove(ids[0]);
+    store.remove(ids[3]);
+    EXPECT_EQ(store.size(), 8);
+    store.remove(ids[4]);
+    store.remove(ids[6]);
+    store.remove(ids[7]);
+    store.remove(ids[8]);
+    EXPECT_EQ(store.find(ids[9])->getName(), "9");
+
+    std::vector<std::string> order;
+    for (const auto& assignment : store.all())
+        order.push_back(assignment->getName());
+    EXPECT_EQ(order, (std::vector<std::string>{"1", "2", "5", "9"}));
+
+    const auto& art = store.bySubject("Art");
+    ASSERT_EQ(art.size(), 3);
+    EXPECT_EQ(art[0]->getName(), "1");
+    EXPECT_EQ(art[2]->getName(), "9");
+    EXPECT_EQ(store.subjectPosting(SubjectTable::global().find("Math"))->totalHours, 4);
+
+    // Positions stay valid after compaction
+    EXPECT_TRUE(store.update(ids[5], createAssignment("Art", "5b", 2, 1)));
+    EXPECT_EQ(store.at(2)->getName(), "5b");
+    EXPECT_TRUE(store.remove(ids[1]));
+    EXPECT_EQ(store.bySubject("Art")[0]->getName(), "5b");
+}
+
+// Test that the maximum id is never kept, so fresh ids cannot wrap to 0
+TEST(AssignmentStoreTest, MaximumIdIsRenumbered) {
+    auto huge = createAssignment("Math", "Huge", 4, 2);
+    huge->setId(std::numeric_limits<AssignmentId>::max());
+    auto nearly = createAssignment("Math", "Nearly", 4, 2);
+    nearly->setId(std::numeric_limits<AssignmentId>::max() - 1);
+
+    AssignmentStore store({nearly, huge});
+    EXPECT_EQ(store.at(0)->getId(), std::numeric_limits<AssignmentId>::max() - 1);
+    AssignmentId renumbered = store.at(1)->getId();
+    EXPECT_NE(renumbered, 0);
+    EXPECT_NE(renumbered, std::numeric_limits<AssignmentId>::max());
+
+    AssignmentId added = store.add(createAssignment("Art", "New", 6, 3));
+    EXPECT_NE(added, 0);
+    EXPECT_NE(added, renumbered);
+    EXPECT_NE(added, std::numeric_limits<AssignmentId>::max());
+    EXPECT_EQ(store.find(added)->getName(), "New");
+}
+
+// Test the per-subject aggregates kept with the posting lists
+TEST(AssignmentStoreTest, SubjectAggregates) {
+    AssignmentStore store({
+        createAssignment("Math", "A", 9, 4),
+        createAssignment("Art", "B", 2, 12),
+        createAssignment("Math", "C", 5, 1)
+    });
+
+    const auto* math = store.subjectPosting(SubjectTable::global().find("Math"));
+    ASSERT_NE(math, nullptr);
+    EXPECT_EQ(math->assignments.size(), 2);
+    EXPECT_EQ(math->totalHours, 5);
+
+    store.removeAt(1);
+    EXPECT_EQ(store.subjectPosting(SubjectTable::global().find("Art")), nullptr);
+}
+
+// Test the store-backed due-within view
+TEST(AssignmentStoreTest, DisplayDueWithinUsesIndex) {
+    AssignmentStore store({
+        createAssignment("Math", "Later", 9, 4),
+        createAssignment("Math", "Soon", 2, 1)
+    });
+
+    testing::internal::CaptureStdout();
+    DisplayFunctions::displayAssignmentsDueWithin(store, 3);
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_NE(output.find("Name: Soon"), std::string::npos);
+    EXPECT_EQ(output.find("Name: Later"), std::string::npos);
+}
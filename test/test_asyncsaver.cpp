@@ -0,0 +1,54 @@
+#include "gtest/gtest.h"
+#include "../include/asyncsaver.hpp"
+#include "../include/planner.hpp"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+static std::shared_ptr<Assignment> createAssignment(const std::string& subject, const std::string& name, int deadline,
+                                                    int duration, float weight, int size, bool groupWork, int groupSize) {
+    return std::make_shared<Assignment>(subject, name, deadline, duration, weight, size, groupWork, groupSize);
+}
+
+// Test that flush() waits until the latest snapshot is on disk
+TEST(AsyncSaverTest, FlushWritesLatestSnapshot) {
+    const std::string filename = "async_latest.json";
+    std::vector<AsyncSaver::AssignmentPtr> assignments;
+    {
+        AsyncSaver saver;
+        for (int i = 0; i < 20; ++i) {
+            assignments.push_back(createAssignment("Math", "HW " + std::to_string(i), i + 1, 2, 5.0f, 2, false, 1));
+            saver.save(filename, assignments);
+        }
+        saver.flush();
+
+        auto stats = saver.stats();
+        EXPECT_EQ(stats.requested, 20);
+        EXPECT_EQ(stats.written + stats.coalesced, 20);
+        EXPECT_GE(stats.written, 1);
+    }
+
+    auto loaded = Planner::loadFromFile(filename);
+    ASSERT_EQ(loaded.size(), 20);
+    EXPECT_EQ(loaded.back()->getName(), "HW 19");
+    std::remove(filename.c_str());
+}
+
+// Test that destroying the saver writes every queued file
+TEST(AsyncSaverTest, DestructorFlushesAllFiles) {
+    const std::vector<std::string> filenames = {"async_a.json", "async_b.json", "async_c.json"};
+    {
+        AsyncSaver saver;
+        for (std::size_t i = 0; i < filenames.size(); ++i) {
+            std::vector<AsyncSaver::AssignmentPtr> snapshot(
+                i + 1, createAssignment("Art", "Sketch", 3, 1, 2.0f, 3, false, 1));
+            saver.save(filenames[i], std::move(snapshot));
+        }
+    }
+
+    for (std::size_t i = 0; i < filenames.size(); ++i) {
+        EXPECT_EQ(Planner::loadFromFile(filenames[i]).size(), i + 1) << filenames[i];
+        std::remove(filenames[i].c_str());
+    }
+}
@@ -0,0 +1,245 @@
+#include "gtest/gtest.h"
+#include "../include/busycalendar.hpp"
+#include "../include/studycalendar.hpp"
+#include "../include/timegrid.hpp"
+#include "FileException.hpp"
+#include <cstdlib>
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+static long long minutesAt(int year, int month, int day, int hour = 0, int minute = 0) {
+    return CivilDate{year, month, day}.toDays() * 1440 + hour * 60 + minute;
+}
+
+static std::string wrap(const std::string& events) {
+    return "BEGIN:VCALENDAR\r\nVERSION:2.0\r\n" + events + "END:VCALENDAR\r\n";
+}
+
+// Test a plain event, with CRLF line endings and a folded line
+TEST(BusyCalendarTest, ParsesEvent) {
+    BusyCalendar busy = BusyCalendar::parse(wrap(
+        "BEGIN:VEVENT\r\nSUMMARY:Lecture\r\nDTSTART;TZID=Europe/Madrid:20261020T180000\r\n"
+        "DTEND;TZID=Europe/Madrid:2026102\r\n 0T193000\r\nEND:VEVENT\r\n"), 0);
+
+    ASSERT_EQ(busy.events().size(), 1);
+    EXPECT_EQ(busy.events()[0].start, minutesAt(2026, 10, 20, 18));
+    EXPECT_EQ(busy.events()[0].duration, 90);
+    EXPECT_EQ(busy.events()[0].frequency, BusyEvent::Frequency::Once);
+    EXPECT_EQ(busy.skipped(), 0);
+}
+
+// Test UTC times, all-day events, DURATION and nested alarms
+TEST(BusyCalendarTest, TimeFormats) {
+    BusyCalendar busy = BusyCalendar::parse(wrap(
+        "BEGIN:VEVENT\nDTSTART:20261020T170000Z\nDURATION:PT45M\n"
+        "BEGIN:VALARM\nTRIGGER:-PT15M\nDTSTART:19990101T000000\nEND:VALARM\nEND:VEVENT\n"
+        "BEGIN:VEVENT\nDTSTART;VALUE=DATE:20261024\nEND:VEVENT\n"
+        "BEGIN:VEVENT\nDTSTART;VALUE=DATE:20261101\nDTEND;VALUE=DATE:20261103\nEND:VEVENT\n"), 120);
+
+    ASSERT_EQ(busy.events().size(), 3);
+    EXPECT_EQ(busy.events()[0].start, minutesAt(2026, 10, 20, 19));
+    EXPECT_EQ(busy.events()[0].duration, 45);
+    EXPECT_EQ(busy.events()[1].start, minutesAt(2026, 10, 24));
+    EXPECT_EQ(busy.events()[1].duration, 1440);
+    EXPECT_EQ(busy.events()[2].duration, 2 * 1440);
+}
+
+// Test that UTC times in the system zone use the offset of their own instant, across a DST change
+TEST(BusyCalendarTest, UtcTimesAcrossDaylightSaving) {
+    const char* saved = std::getenv("TZ");
+    const std::string savedZone = saved ? saved : "";
+    setenv("TZ", "CET-1CEST,M3.5.0,M10.5.0/3", 1); // Central Europe without needing tzdata
+    tzset();
+
+    BusyCalendar busy = BusyCalendar::parse(wrap(
+        "BEGIN:VEVENT\nDTSTART:20261020T160000Z\nDURATION:PT1H\nEND:VEVENT\n"
+        "BEGIN:VEVENT\nDTSTART:20261110T170000Z\nDURATION:PT1H\nEND:VEVENT\n"
+        "BEGIN:VEVENT\nDTSTART:20261020T180000\nDTEND;TZID=America/New_York:20261020T190000\nEND:VEVENT\n"));
+    const int summer = BusyCalendar::localUtcOffsetMinutes(minutesAt(2026, 7, 1));
+    const int winter = BusyCalendar::localUtcOffsetMinutes(minutesAt(2026, 12, 1));
+
+    if (saved)
+        setenv("TZ", savedZone.c_str(), 1);
+    else
+        unsetenv("TZ");
+    tzset();
+
+    EXPECT_EQ(summer, 120);
+    EXPECT_EQ(winter, 60);
+    ASSERT_EQ(busy.events().size(), 3);
+    EXPECT_EQ(busy.events()[0].start, minutesAt(2026, 10, 20, 18));
+    EXPECT_EQ(busy.events()[1].start, minutesAt(2026, 11, 10, 18));
+    EXPECT_EQ(busy.events()[2].duration, 60); // TZID times are floating local time
+}
+
+// Test that free, cancelled, empty and malformed events block nothing
+TEST(BusyCalendarTest, SkipsEventsThatBlockNothing) {
+    BusyCalendar busy = BusyCalendar::parse(wrap(
+        "BEGIN:VEVENT\nDTSTART:20261020T180000\nDTEND:20261020T190000\nTRANSP:TRANSPARENT\nEND:VEVENT\n"
+        "BEGIN:VEVENT\nDTSTART:20261020T180000\nDTEND:20261020T190000\nSTATUS:CANCELLED\nEND:VEVENT\n"
+        "BEGIN:VEVENT\nDTSTART:20261020T180000\nEND:VEVENT\n"
+        "BEGIN:VEVENT\nDTSTART:2026-10-20 18:00\nEND:VEVENT\n"
+        "BEGIN:VEVENT\nSUMMARY:No start\nEND:VEVENT\n"), 0);
+
+    EXPECT_TRUE(busy.events().empty());
+    EXPECT_EQ(busy.skipped(), 2);
+}
+
+// Test recurrence rule parsing
+TEST(BusyCalendarTest, ParsesRules) {
+    BusyCalendar busy = BusyCalendar::parse(wrap(
+        "BEGIN:VEVENT\nDTSTART:20261019T180000\nDTEND:20261019T200000\n"
+        "RRULE:FREQ=WEEKLY;INTERVAL=2;BYDAY=MO,WE;UNTIL=20261231\nEND:VEVENT\n"
+        "BEGIN:VEVENT\nDTSTART:20261019T180000\nDTEND:20261019T200000\nRRULE:FREQ=DAILY;COUNT=5\nEND:VEVENT\n"
+        "BEGIN:VEVENT\nDTSTART:20261019T180000\nDTEND:20261019T200000\nRRULE:FREQ=MONTHLY;BYMONTHDAY=1\nEND:VEVENT\n"), 0);
+
+    ASSERT_EQ(busy.events().size(), 3);
+    EXPECT_EQ(busy.events()[0].frequency, BusyEvent::Frequency::Weekly);
+    EXPECT_EQ(busy.events()[0].interval, 2);
+    EXPECT_EQ(busy.events()[0].weekdays, (1u << 1) | (1u << 3));
+    EXPECT_EQ(busy.events()[0].until, minutesAt(2026, 12, 31, 23, 59));
+    EXPECT_EQ(busy.events()[1].count, 5);
+    EXPECT_EQ(busy.events()[2].frequency, BusyEvent::Frequency::Daily); // Conservative stand-in
+    EXPECT_EQ(busy.events()[2].count, -1);
+    EXPECT_EQ(busy.unsupportedRules(), 1);
+}
+
+// Test that rules the parser does not understand still block every occurrence, and more
+TEST(BusyCalendarTest, BlocksUnsupportedRulesConservatively) {
+    BusyCalendar busy = BusyCalendar::parse(wrap(
+        "BEGIN:VEVENT\nDTSTART:20261019T190000\nDTEND:20261019T200000\n"
+        "RRULE:FREQ=MONTHLY;BYDAY=MO;BYSETPOS=-1;COUNT=3;UNTIL=20261105\nEND:VEVENT\n"
+        "BEGIN:VEVENT\nDTSTART:20261110T090000\nDTEND:20261110T093000\n"
+        "RRULE:FREQ=DAILY;BYHOUR=9,21\nEND:VEVENT\n"), 0);
+    EXPECT_EQ(busy.unsupportedRules(), 2);
+
+    TimeGrid grid(30, 60, 18 * 60, 6 * 60); // 18:00-24:00, days 1..30 from 2026-10-20
+    busy.block(grid, CivilDate{2026, 10, 19});
+
+    // The monthly event's hour is busy every day through its UNTIL, and free afterwards
+    EXPECT_FALSE(grid.isFree(1, 1));
+    EXPECT_FALSE(grid.isFree(17, 1)); // 2026-11-05
+    EXPECT_TRUE(grid.isFree(18, 1));
+    // BYHOUR moves the time of day, so whole days are busy from the first occurrence on
+    EXPECT_EQ(grid.freeSlots(21), 6);
+    EXPECT_EQ(grid.freeSlots(22), 0); // 2026-11-10
+    EXPECT_EQ(grid.freeSlots(30), 0);
+}
+
+// Test blocking events into study windows, including windows that cross midnight
+TEST(BusyCalendarTest, BlocksGrid) {
+    BusyCalendar busy = BusyCalendar::parse(wrap(
+        "BEGIN:VEVENT\nDTSTART:20261020T183000\nDTEND:20261020T191500\nEND:VEVENT\n"   // Day 1
+        "BEGIN:VEVENT\nDTSTART:20261022T000000\nDTEND:20261022T003000\nEND:VEVENT\n"   // Day 2, after midnight
+        "BEGIN:VEVENT\nDTSTART:20261023T090000\nDTEND:20261023T100000\nEND:VEVENT\n"), 0); // Outside the window
+
+    TimeGrid grid(4, 30, 18 * 60, 8 * 60); // 18:00-02:00
+    busy.block(grid, CivilDate{2026, 10, 19});
+
+    EXPECT_TRUE(grid.isFree(1, 0));
+    EXPECT_FALSE(grid.isFree(1, 1));
+    EXPECT_FALSE(grid.isFree(1, 2)); // Partly busy slots are busy
+    EXPECT_TRUE(grid.isFree(1, 3));
+    EXPECT_EQ(grid.freeSlots(1), 14);
+    EXPECT_FALSE(grid.isFree(2, 12));
+    EXPECT_EQ(grid.freeSlots(2), 15);
+    EXPECT_EQ(grid.freeSlots(3), 16);
+    EXPECT_EQ(grid.freeSlots(4), 16);
+}
+
+// Naive expansion of a recurrence, one day at a time from its first occurrence
+static void blockNaively(const BusyEvent& event, TimeGrid& grid, const CivilDate& base) {
+    const long long firstWindow = (base.toDays() + 1) * 1440 + grid.windowStart();
+    const long long windowMinutes = grid.slotsPerDay() * grid.slotMinutes();
+    auto blockOccurrence = [&](long long start) {
+        for (int day = 1; day <= grid.days(); ++day) {
+            long long windowStart = firstWindow + (day - 1) * 1440;
+            for (int slot = 0; slot < grid.slotsPerDay(); ++slot) {
+                long long slotStart = windowStart + slot * grid.slotMinutes();
+                if (slotStart < start + event.duration && slotStart + grid.slotMinutes() > start && slotStart < windowStart + windowMinutes)
+                    grid.block(day, slot, 1);
+            }
+        }
+    };
+
+    const long long startDay = event.start / 1440;
+    const long long timeOfDay = event.start % 1440;
+    const long long weekStart = startDay - (CivilDate::fromDays(startDay).weekday() + 6) % 7;
+    long long index = 0;
+    for (long long day = startDay; day < startDay + 800; ++day) {
+        bool occurs;
+        int weekday = CivilDate::fromDays(day).weekday();
+        if (event.frequency == BusyEvent::Frequency::Once)
+            occurs = day == startDay;
+        else if (event.frequency == BusyEvent::Frequency::Daily)
+            occurs = (day - startDay) % event.interval == 0 && (event.weekdays == 0 || ((event.weekdays >> weekday) & 1));
+        else
+            occurs = ((day - weekStart) / 7) % event.interval == 0 &&
+                     (event.weekdays == 0 ? weekday == CivilDate::fromDays(startDay).weekday() : ((event.weekdays >> weekday) & 1));
+        if (!occurs)
+            continue;
+        long long start = day * 1440 + timeOfDay;
+        if ((event.count >= 0 && index >= event.count) || start > event.until)
+            break;
+        ++index;
+        blockOccurrence(start);
+    }
+}
+
+// Differential test: recurrence expansion with skipping must match the naive expansion
+TEST(BusyCalendarTest, RecurrenceMatchesNaiveExpansion) {
+    static const char* const days[7] = {"SU", "MO", "TU", "WE", "TH", "FR", "SA"};
+    std::mt19937 rng(2026);
+    const CivilDate base{2026, 10, 19};
+
+    for (int n = 0; n < 300; ++n) {
+        // Start anywhere from months before the horizon to inside it
+        CivilDate start = base.plusDays(static_cast<int>(rng() % 120) - 90);
+        int hour = static_cast<int>(rng() % 24);
+        int minutes = 15 + static_cast<int>(rng() % 40) * 15;
+        std::string rule = rng() % 2 ? "FREQ=DAILY" : "FREQ=WEEKLY";
+        if (rng() % 2)
+            rule += ";INTERVAL=" + std::to_string(1 + rng() % 4);
+        if (rng() % 2)
+            rule += ";COUNT=" + std::to_string(1 + rng() % 60);
+        if (rng() % 3 == 0)
+            rule += ";UNTIL=" + start.plusDays(static_cast<int>(rng() % 200)).toString().erase(7, 1).erase(4, 1);
+        if (rng() % 2) {
+            rule += ";BYDAY=";
+            int picks = 1 + static_cast<int>(rng() % 3);
+            for (int i = 0; i < picks; ++i)
+                rule += std::string(i ? "," : "") + days[rng() % 7];
+        }
+
+        char dtstart[32];
+        std::snprintf(dtstart, sizeof(dtstart), "%04d%02d%02dT%02d0000", start.year, start.month, start.day, hour);
+        std::string text = wrap("BEGIN:VEVENT\nDTSTART:" + std::string(dtstart) + "\nDURATION:PT" + std::to_string(minutes) +
+                                "M\nRRULE:" + rule + "\nEND:VEVENT\n");
+        BusyCalendar busy = BusyCalendar::parse(text, 0);
+        ASSERT_EQ(busy.events().size(), 1) << text;
+
+        TimeGrid fast(40, 30, 17 * 60, 10 * 60);
+        TimeGrid naive(40, 30, 17 * 60, 10 * 60);
+        busy.block(fast, base);
+        blockNaively(busy.events()[0], naive, base);
+        for (int day = 1; day <= 40; ++day)
+            for (int slot = 0; slot < fast.slotsPerDay(); ++slot)
+                ASSERT_EQ(fast.isFree(day, slot), naive.isFree(day, slot)) << text << " day " << day << " slot " << slot;
+    }
+}
+
+// Test that a calendar's busy times reduce the grid it builds
+TEST(BusyCalendarTest, StudyCalendarBlocksBusyTimes) {
+    StudyCalendar calendar(3, 3);
+    calendar.setStudyWindow(18 * 60, 4 * 60);
+    calendar.setBusyTimes(BusyCalendar::parse(wrap(
+        "BEGIN:VEVENT\nDTSTART:20261020T180000\nDTEND:20261020T200000\nRRULE:FREQ=DAILY;COUNT=2\nEND:VEVENT\n"), 0));
+
+    TimeGrid grid = calendar.timeGrid(CivilDate{2026, 10, 19}, 3);
+    EXPECT_EQ(grid.freeHours(1), 2);
+    EXPECT_EQ(grid.freeHours(2), 2);
+    EXPECT_EQ(grid.freeHours(3), 4);
+    EXPECT_THROW(BusyCalendar::fromFile("Data/no_such_calendar.ics"), FileException);
+}
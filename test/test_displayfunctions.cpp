@@ -179,3 +179,31 @@ TEST(DisplayFunctionsTest, DisplayAssignmentsByBiggestDuration) {
 
     EXPECT_EQ(output, expectedOutput);
 }
+
+// Test DisplayFunctions::displayAssignmentsByShortestDeadline with a row limit
+TEST(DisplayFunctionsTest, DisplayAssignmentsByShortestDeadline_Limit) {
+    auto assignment1 = createAssignment("Math", "Math Homework", 5, 10, 20.0, 1, false, 1);
+    auto assignment2 = createAssignment("Science", "Science Project", 3, 15, 25.0, 1, false, 1);
+
+    std::vector<DisplayFunctions::AssignmentPtr> assignments = {assignment1, assignment2};
+
+    testing::internal::CaptureStdout();
+    DisplayFunctions::displayAssignmentsByShortestDeadline(assignments, 1);
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_NE(output.find("Name: Science Project"), std::string::npos);
+    EXPECT_EQ(output.find("Name: Math Homework"), std::string::npos);
+}
+
+// Test DisplayFunctions::displayAssignmentsDueWithin with no match
+TEST(DisplayFunctionsTest, DisplayAssignmentsDueWithin_NoMatch) {
+    auto assignment = createAssignment("Math", "Math Homework", 5, 10, 20.0, 1, false, 1);
+
+    std::vector<DisplayFunctions::AssignmentPtr> assignments = {assignment};
+
+    testing::internal::CaptureStdout();
+    DisplayFunctions::displayAssignmentsDueWithin(assignments, 2);
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(output, "\nAssignments Due Within 2 Days:\nNo assignments due within 2 days.\n");
+}
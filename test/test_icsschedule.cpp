@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+#include "../include/icsschedule.hpp"
+#include "../include/assignment.hpp"
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static IcsEvent makeEvent(const std::string& uid, const std::string& summary, const std::string& start, const std::string& end,
+                          int sequence = 0) {
+    IcsEvent event;
+    event.uid = uid;
+    event.summary = summary;
+    event.start = start;
+    event.end = end;
+    event.sequence = sequence;
+    return event;
+}
+
+// Test date-time formatting, including times past midnight
+TEST(IcsScheduleTest, FormatDateTime) {
+    EXPECT_EQ(IcsSchedule::formatDateTime(CivilDate{2026, 10, 19}, 18 * 60 + 15), "20261019T181500");
+    EXPECT_EQ(IcsSchedule::formatDateTime(CivilDate{2026, 12, 31}, 24 * 60 + 30), "20270101T003000");
+    EXPECT_EQ(IcsSchedule::formatDateTime(CivilDate{2026, 3, 1}, -60), "20260228T230000");
+    EXPECT_EQ(IcsSchedule::formatDateTime(CivilDate{9999, 12, 31}, 0), "99991231T000000");
+    EXPECT_THROW(IcsSchedule::formatDateTime(CivilDate{-1, 6, 1}, 0), std::out_of_range);
+    EXPECT_THROW(IcsSchedule::formatDateTime(CivilDate{9999, 12, 31}, 24 * 60), std::out_of_range);
+}
+
+// Test that session UIDs are stable and distinct
+TEST(IcsScheduleTest, SessionUid) {
+    Assignment stored("Math", "Essay", 3, 4, 10.0f, 1, false, 1);
+    stored.setId(42);
+    EXPECT_EQ(IcsSchedule::sessionUid(stored, 3), "a42-s3@planner-app");
+
+    Assignment unsaved("Math", "Essay", 3, 4, 10.0f, 1, false, 1);
+    Assignment same("Math", "Essay", 9, 1, 30.0f, 2, false, 1);
+    Assignment other("Physics", "Essay", 3, 4, 10.0f, 1, false, 1);
+    EXPECT_EQ(IcsSchedule::sessionUid(unsaved, 1), IcsSchedule::sessionUid(same, 1));
+    EXPECT_NE(IcsSchedule::sessionUid(unsaved, 1), IcsSchedule::sessionUid(other, 1));
+    EXPECT_NE(IcsSchedule::sessionUid(unsaved, 1), IcsSchedule::sessionUid(unsaved, 2));
+}
+
+// Test that written events read back, and that events without a UID are ignored
+TEST(IcsScheduleTest, WriteAndReadEvents) {
+    std::ostringstream out;
+    out << "BEGIN:VCALENDAR\n";
+    IcsSchedule::writeEvent(out, makeEvent("a1-s1@planner-app", "Essay", "20261020T180000", "20261020T190000", 2), "20261019T000000Z");
+    out << "BEGIN:VEVENT\nSUMMARY:Legacy\nDTSTART:20261020T190000\nEND:VEVENT\n";
+    out << "BEGIN:VEVENT\r\nUID:a1-s2@planner-\r\n app\r\nSUMMARY:Essay\r\nEND:VEVENT\r\n";
+    out << "END:VCALENDAR\n";
+
+    std::vector<IcsEvent> events = IcsSchedule::readEvents(out.str());
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].uid, "a1-s1@planner-app");
+    EXPECT_EQ(events[0].summary, "Essay");
+    EXPECT_EQ(events[0].start, "20261020T180000");
+    EXPECT_EQ(events[0].end, "20261020T190000");
+    EXPECT_EQ(events[0].sequence, 2);
+    EXPECT_EQ(events[1].uid, "a1-s2@planner-app");
+}
+
+// Test added, changed, unchanged and cancelled events and their sequence numbers
+TEST(IcsScheduleTest, Diff) {
+    std::vector<IcsEvent> previous = {
+        makeEvent("a", "Essay", "20261020T180000", "20261020T190000", 0),
+        makeEvent("b", "Essay", "20261021T180000", "20261021T190000", 3),
+        makeEvent("c", "Lab", "20261021T190000", "20261021T200000", 1)
+    };
+    std::vector<IcsEvent> current = {
+        makeEvent("a", "Essay", "20261020T180000", "20261020T190000"),
+        makeEvent("b", "Essay", "20261021T190000", "20261021T200000"),
+        makeEvent("d", "Reading", "20261022T180000", "20261022T190000")
+    };
+
+    IcsSchedule::Delta delta = IcsSchedule::diff(previous, current);
+    EXPECT_EQ(delta.unchanged, 1);
+    ASSERT_EQ(delta.published.size(), 2);
+    EXPECT_EQ(delta.published[0].uid, "b");
+    EXPECT_EQ(delta.published[0].sequence, 4);
+    EXPECT_EQ(delta.published[1].uid, "d");
+    EXPECT_EQ(delta.published[1].sequence, 0);
+    ASSERT_EQ(delta.cancelled.size(), 1);
+    EXPECT_EQ(delta.cancelled[0].uid, "c");
+    EXPECT_EQ(delta.cancelled[0].sequence, 2);
+    EXPECT_EQ(current[1].sequence, 4);
+}
+
+// Test the delta calendars
+TEST(IcsScheduleTest, WriteDelta) {
+    IcsSchedule::Delta delta;
+    std::ostringstream empty;
+    IcsSchedule::writeDelta(empty, delta, CivilDate{2026, 10, 19});
+    EXPECT_TRUE(empty.str().empty());
+
+    delta.cancelled.push_back(makeEvent("c", "Lab", "20261021T190000", "20261021T200000", 2));
+    std::ostringstream out;
+    IcsSchedule::writeDelta(out, delta, CivilDate{2026, 10, 19});
+    EXPECT_EQ(out.str(),
+              "BEGIN:VCALENDAR\nVERSION:2.0\nPRODID:-//Planner App//EN\nMETHOD:CANCEL\n"
+              "BEGIN:VEVENT\nUID:c\nDTSTAMP:20261019T000000Z\nSEQUENCE:2\nSUMMARY:Lab\nDTSTART:20261021T190000\n"
+              "DTEND:20261021T200000\nDESCRIPTION:Scheduled Assignment\nSTATUS:CANCELLED\nEND:VEVENT\nEND:VCALENDAR\n");
+}
+
+// Test that adjacent sessions merge and daily repeats fold into one RRULE event with EXDATEs
+TEST(IcsScheduleTest, BuildEventsCompresses) {
+    std::vector<std::shared_ptr<Assignment>> assignments = {
+        std::make_shared<Assignment>("CS", "Final Project", 30, 20, 30.0f, 1, false, 1),
+        std::make_shared<Assignment>("Math", "Homework", 3, 1, 10.0f, 1, false, 1)
+    };
+    assignments[0]->setId(9);
+    assignments[1]->setId(4);
+
+    std::vector<IcsSession> sessions;
+    for (int day : {1, 2, 3, 5, 6, 10}) {
+        sessions.push_back({0, day, 18 * 60, 19 * 60});
+        sessions.push_back({0, day, 19 * 60, 20 * 60});
+    }
+    sessions.push_back({1, 2, 20 * 60, 21 * 60});
+    std::sort(sessions.begin(), sessions.end(), [](const IcsSession& a, const IcsSession& b) {
+        return a.day != b.day ? a.day < b.day : a.startMinute < b.startMinute;
+    });
+
+    std::vector<IcsEvent> events = IcsSchedule::buildEvents(sessions, assignments, CivilDate{2026, 10, 19}, true);
+    ASSERT_EQ(events.size(), 3);
+    EXPECT_EQ(events[0].uid, "a9-s1@planner-app");
+    EXPECT_EQ(events[0].start, "20261020T180000");
+    EXPECT_EQ(events[0].end, "20261020T200000");
+    EXPECT_EQ(events[0].rrule, "FREQ=DAILY;COUNT=6");
+    EXPECT_EQ(events[0].exdates, std::vector<std::string>({"20261023T180000"}));
+    EXPECT_EQ(events[1].summary, "Homework");
+    EXPECT_TRUE(events[1].rrule.empty());
+    // Three idle days are too long a gap for one series
+    EXPECT_EQ(events[2].uid, "a9-s2@planner-app");
+    EXPECT_EQ(events[2].start, "20261029T180000");
+    EXPECT_TRUE(events[2].rrule.empty());
+
+    std::vector<IcsEvent> expanded = IcsSchedule::buildEvents(sessions, assignments, CivilDate{2026, 10, 19}, false);
+    EXPECT_EQ(expanded.size(), sessions.size());
+    EXPECT_EQ(expanded[1].uid, "a9-s2@planner-app");
+    EXPECT_EQ(expanded[1].start, "20261020T190000");
+
+    // The series reads back with its recurrence
+    std::ostringstream out;
+    IcsSchedule::writeEvent(out, events[0], "20261019T000000Z");
+    std::vector<IcsEvent> read = IcsSchedule::readEvents(out.str());
+    ASSERT_EQ(read.size(), 1);
+    EXPECT_EQ(read[0].rrule, events[0].rrule);
+    EXPECT_EQ(read[0].exdates, events[0].exdates);
+}
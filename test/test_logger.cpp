@@ -0,0 +1,171 @@
+#include "gtest/gtest.h"
+#include "../include/logger.hpp"
+#include "../include/planner.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// Logger tests capture both streams and restore the defaults afterwards
+class LoggerTest : public ::testing::Test {
+protected:
+    std::ostringstream out;
+    std::ostringstream errors;
+    LogLevel savedLevel = LogLevel::Info;
+
+    void SetUp() override {
+        savedLevel = Log::level();
+        Log::setStreams(out, errors);
+    }
+
+    void TearDown() override {
+        Log::setStreams(std::cout, std::cerr);
+        Log::setLevel(savedLevel);
+    }
+};
+
+static int sideEffects = 0;
+
+static int countedValue() {
+    ++sideEffects;
+    return 42;
+}
+
+// Test level names and the runtime threshold
+TEST_F(LoggerTest, Levels) {
+    EXPECT_EQ(Log::parseLevel("debug"), LogLevel::Debug);
+    EXPECT_EQ(Log::parseLevel("off"), LogLevel::Off);
+    EXPECT_THROW(Log::parseLevel("verbose"), std::invalid_argument);
+
+    Log::setLevel(LogLevel::Warn);
+    EXPECT_FALSE(Log::enabled(LogLevel::Info));
+    EXPECT_TRUE(Log::enabled(LogLevel::Error));
+    Log::setLevel(LogLevel::Off);
+    EXPECT_FALSE(Log::enabled(LogLevel::Error));
+    EXPECT_FALSE(Log::enabled(LogLevel::Off));
+}
+
+// Test that records reach their stream in order, with prefixes for warnings and errors
+TEST_F(LoggerTest, WritesRecords) {
+    Log::setLevel(LogLevel::Debug);
+    LOG_DEBUG("Day " << 3 << ":");
+    LOG_INFO("weight " << 12.5 << ", id " << 18446744073709551615ull);
+    LOG_WARN("careful");
+    LOG_ERROR("Could not open file " << std::string("x.json") << " for reading.");
+    Log::flush();
+
+    EXPECT_EQ(out.str(), "Day 3:\nweight 12.5, id 18446744073709551615\n");
+    EXPECT_EQ(errors.str(), "Warning: careful\nError: Could not open file x.json for reading.\n");
+}
+
+// Test that disabled and compiled-out records do not evaluate their arguments
+TEST_F(LoggerTest, DisabledRecordsCostNothing) {
+    sideEffects = 0;
+    Log::setLevel(LogLevel::Warn);
+    LOG_INFO("value " << countedValue());
+    EXPECT_EQ(sideEffects, 0);
+
+    Log::setLevel(LogLevel::Trace);
+    LOG_TRACE("value " << countedValue());
+    Log::flush();
+#if PLANNER_LOG_MIN_LEVEL > 0
+    EXPECT_EQ(sideEffects, 0);
+    EXPECT_EQ(out.str(), "");
+#else
+    EXPECT_EQ(sideEffects, 1);
+    EXPECT_EQ(out.str(), "value 42\n");
+#endif
+}
+
+// Test that under Overflow::Drop a burst larger than the ring drops only low-level records, and says so
+TEST_F(LoggerTest, FullRingDropsLowLevelRecords) {
+    Log::setLevel(LogLevel::Info);
+    Log::setOverflow(Log::Overflow::Drop);
+    const std::size_t droppedBefore = Log::dropped();
+    const int count = static_cast<int>(Log::RingCapacity) * 4;
+    for (int i = 0; i < count; ++i) {
+        LOG_INFO("info " << i);
+        LOG_WARN("warn " << i);
+    }
+    Log::flush();
+
+    std::size_t infoLines = 0, warnLines = 0;
+    std::istringstream outLines(out.str());
+    for (std::string line; std::getline(outLines, line);)
+        infoLines += line.rfind("info ", 0) == 0;
+    std::istringstream errorLines(errors.str());
+    for (std::string line; std::getline(errorLines, line);)
+        warnLines += line.rfind("Warning: warn ", 0) == 0;
+
+    EXPECT_EQ(warnLines, static_cast<std::size_t>(count));
+    EXPECT_EQ(infoLines + (Log::dropped() - droppedBefore), static_cast<std::size_t>(count));
+    if (Log::dropped() > droppedBefore) {
+        EXPECT_NE(errors.str().find(" log records dropped\n"), std::string::npos);
+    }
+    Log::setOverflow(Log::Overflow::Block);
+}
+
+// Stream buffer that pauses now and then, so the writer falls behind its producers
+class SlowBuffer : public std::stringbuf {
+protected:
+    std::streamsize xsputn(const char* text, std::streamsize count) override {
+        if (++writes % 200 == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return std::stringbuf::xsputn(text, count);
+    }
+
+private:
+    std::size_t writes = 0;
+};
+
+// Test that a schedule listing longer than the ring reaches a slow stream line for line
+TEST_F(LoggerTest, ScheduleListingIsNotLossy) {
+    std::vector<Planner::AssignmentPtr> assignments;
+    for (int i = 0; i < 60; ++i)
+        assignments.push_back(std::make_shared<Assignment>("Math", "Task " + std::to_string(i), 400, 100, 10.0f, 1, false, 1));
+    std::filesystem::create_directory("Data");
+
+    NullScheduleSink counter;
+    Planner::emitSchedule(assignments, StudyCalendar(24, 24), CivilDate{2026, 12, 30}, counter);
+    ASSERT_GT(counter.sessions(), Log::RingCapacity);
+
+    SlowBuffer slow;
+    std::ostream slowOut(&slow);
+    Log::setStreams(slowOut, errors);
+    const std::size_t droppedBefore = Log::dropped();
+    Log::setLevel(LogLevel::Debug);
+    Planner::scheduler(assignments, StudyCalendar(24, 24), "test_logger_user", CivilDate{2026, 12, 30});
+    Log::flush();
+    Log::setStreams(out, errors);
+
+    std::size_t hourLines = 0;
+    std::istringstream lines(slow.str());
+    for (std::string line; std::getline(lines, line);)
+        hourLines += line.rfind("Hour ", 0) == 0;
+    EXPECT_EQ(hourLines, counter.sessions());
+    EXPECT_EQ(Log::dropped(), droppedBefore);
+    std::remove("Data/test_logger_user_schedule.ics");
+}
+
+// Test that the scheduler lists study hours only at debug level
+TEST_F(LoggerTest, SchedulerTraceIsDebug) {
+    std::vector<Planner::AssignmentPtr> assignments = {
+        std::make_shared<Assignment>("Math", "Math Homework", 3, 2, 20.0f, 1, false, 1)
+    };
+    std::filesystem::create_directory("Data");
+
+    Log::setLevel(LogLevel::Info);
+    Planner::scheduler(assignments, StudyCalendar(1, 1), "test_logger_user", CivilDate{2026, 12, 30});
+    Log::flush();
+    EXPECT_EQ(out.str().find("Hour 1"), std::string::npos);
+
+    Log::setLevel(LogLevel::Debug);
+    Planner::scheduler(assignments, StudyCalendar(1, 1), "test_logger_user", CivilDate{2026, 12, 30});
+    Log::flush();
+    EXPECT_NE(out.str().find("\nDay 1:\nHour 1: Math Homework\n"), std::string::npos);
+    std::remove("Data/test_logger_user_schedule.ics");
+}
@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+#include "../include/mappedassignmentstore.hpp"
+#include "../include/planner.hpp"
+#include "../include/scheduleengine.hpp"
+#include "FileException.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+static std::shared_ptr<Assignment> createAssignment(const std::string& subject, const std::string& name, int deadline,
+                                                    int duration, float weight, int size, bool groupWork, int groupSize) {
+    return std::make_shared<Assignment>(subject, name, deadline, duration, weight, size, groupWork, groupSize);
+}
+
+// Test that plain strings are viewed in the mapping and escaped ones are decoded
+TEST(MappedAssignmentStoreTest, ViewsStringsInPlace) {
+    const std::string filename = "mapped_views.json";
+    std::vector<Planner::AssignmentPtr> assignments = {
+        createAssignment("Math", "Homework", 5, 4, 10.0f, 2, false, 1),
+        createAssignment("Art", "Say \"hi\"", 3, 6, 5.5f, 1, true, 3)
+    };
+    assignments[0]->setId(9);
+    Planner::saveToFile(filename, assignments);
+
+    MappedAssignmentStore store(filename);
+    ASSERT_EQ(store.size(), 2);
+    EXPECT_EQ(store.at(0).id, 9u);
+    EXPECT_EQ(store.at(0).subject, "Math");
+    EXPECT_EQ(store.at(0).name, "Homework");
+    EXPECT_EQ(store.at(1).name, "Say \"hi\"");
+    EXPECT_FLOAT_EQ(store.at(1).weight, 5.5f);
+    EXPECT_EQ(store.at(1).realDuration(), 2);
+    EXPECT_EQ(store.decodedStrings(), 1); // Only the escaped name was copied
+
+    // A moved store keeps its views valid
+    MappedAssignmentStore moved(std::move(store));
+    EXPECT_EQ(moved.at(0).name, "Homework");
+    EXPECT_EQ(moved.at(1).name, "Say \"hi\"");
+
+    std::remove(filename.c_str());
+}
+
+// Test that files outside the fast parser's shape still load, and broken ones throw
+TEST(MappedAssignmentStoreTest, GeneralParserFallbackAndErrors) {
+    const std::string filename = "mapped_fallback.json";
+    {
+        std::ofstream file(filename);
+        file << R"([{"subject":"Math","name":"HW","deadline":4,"duration":2,"weight":1,)"
+             << R"("size":1,"group_work":false,"group_size":1,"notes":"kept by hand"}])";
+    }
+    MappedAssignmentStore store(filename);
+    ASSERT_EQ(store.size(), 1);
+    EXPECT_EQ(store.at(0).name, "HW");
+
+    {
+        std::ofstream file(filename, std::ios::trunc);
+        file << "[{";
+    }
+    EXPECT_THROW(MappedAssignmentStore broken(filename), FileException);
+    EXPECT_THROW(MappedAssignmentStore missing("no_such_file.json"), FileException);
+
+    {
+        std::ofstream file(filename, std::ios::trunc);
+        file << R"([{"subject":"Math","name":"HW","deadline":4,"duration":2,"weight":1,)"
+             << R"("size":1,"group_work":true,"group_size":0}])";
+    }
+    EXPECT_THROW(MappedAssignmentStore zeroGroup(filename), FileException);
+
+    std::remove(filename.c_str());
+}
+
+// Test that scheduling mapped views matches scheduling the loaded assignments
+TEST(MappedAssignmentStoreTest, ScheduleMatchesLoadedAssignments) {
+    const std::string filename = "mapped_schedule.json";
+    std::vector<Planner::AssignmentPtr> assignments;
+    for (int i = 0; i < 40; ++i)
+        assignments.push_back(createAssignment("S" + std::to_string(i % 4), "A" + std::to_string(i), i % 9 + 1,
+                                               i % 7 + 1, static_cast<float>(i % 5), i % 3 + 1, i % 4 == 0, i % 4 == 0 ? 2 : 1));
+    Planner::saveToFile(filename, assignments);
+
+    MappedAssignmentStore store(filename);
+    auto mapped = Planner::computeSchedule(store.all(), 3, 5);
+    auto loaded = Planner::computeSchedule(Planner::loadFromFile(filename), 3, 5);
+
+    ASSERT_EQ(mapped.slots.size(), loaded.slots.size());
+    for (std::size_t i = 0; i < mapped.slots.size(); ++i) {
+        EXPECT_EQ(mapped.slots[i].day, loaded.slots[i].day);
+        EXPECT_EQ(mapped.slots[i].assignment, loaded.slots[i].assignment);
+    }
+    EXPECT_EQ(mapped.missed.size(), loaded.missed.size());
+    EXPECT_EQ(mapped.days, loaded.days);
+
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+#include "../include/ndjsonimport.hpp"
+#include "../include/assignmentparser.hpp"
+#include "../include/planner.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+static std::string importLine(const std::string& user, const std::string& name, int deadline) {
+    return R"({"user":")" + user + R"(","subject":"Math","name":")" + name + R"(","deadline":)" +
+           std::to_string(deadline) + R"(,"duration":2,"weight":5,"size":2,"group_work":false,"group_size":1})";
+}
+
+// Test that the import keeps each user's file order regardless of how the text is chunked
+TEST(NdjsonImportTest, ParseGroupsByUserInOrder) {
+    std::string text;
+    for (int i = 0; i < 3000; ++i)
+        text += importLine(i % 3 == 0 ? "alice" : "bob", "HW " + std::to_string(i), i % 30 + 1) + "\n";
+
+    auto single = NdjsonImport::parse(text, 1);
+    auto parallel = NdjsonImport::parse(text, 4);
+
+    EXPECT_EQ(single.assignments, 3000);
+    EXPECT_TRUE(single.badLines.empty());
+    ASSERT_EQ(single.users.size(), 2);
+    ASSERT_EQ(single.users["alice"].size(), 1000);
+    EXPECT_EQ(single.users["alice"][1]->getName(), "HW 3");
+
+    ASSERT_EQ(parallel.users["bob"].size(), single.users["bob"].size());
+    for (std::size_t i = 0; i < single.users["bob"].size(); ++i)
+        EXPECT_EQ(parallel.users["bob"][i]->getName(), single.users["bob"][i]->getName());
+}
+
+// Test that blank lines are skipped and bad lines are reported by line number
+TEST(NdjsonImportTest, ReportsBadLines) {
+    std::string text = importLine("alice", "A", 1) + "\n\n" +
+                       "{not json}\n" +
+                       R"({"subject":"Math","name":"No user","deadline":1,"duration":1,"weight":1,"size":1,"group_work":false,"group_size":1})" + "\n" +
+                       R"({"user":"alice","notes":"extra","subject":"Art","name":"B","deadline":2,"duration":1,"weight":1,"size":1,"group_work":false,"group_size":1})";
+
+    auto result = NdjsonImport::parse(text, 2);
+
+    EXPECT_EQ(result.assignments, 2); // The line with an extra field goes through the general parser
+    ASSERT_EQ(result.badLines.size(), 2);
+    EXPECT_EQ(result.badLines[0], 3);
+    EXPECT_EQ(result.badLines[1], 4);
+}
+
+// Test that well-formed lines with out-of-range fields are bad lines, on both parsers
+TEST(NdjsonImportTest, RejectsOutOfRangeFields) {
+    std::string text = R"({"user":"alice","subject":"Math","name":"Zero group","deadline":1,"duration":2,"weight":1,"size":1,"group_work":true,"group_size":0})" "\n"
+                       R"({"user":"alice","notes":"extra","subject":"Math","name":"Past","deadline":-1,"duration":2,"weight":1,"size":1,"group_work":false,"group_size":1})" "\n" +
+                       importLine("alice", "Fine", 3);
+
+    auto result = NdjsonImport::parse(text, 1);
+
+    EXPECT_EQ(result.assignments, 1);
+    EXPECT_EQ(result.badLines, (std::vector<std::size_t>{1, 2}));
+}
+
+// Test that a user whose existing file cannot be loaded is skipped instead of overwritten
+TEST(NdjsonImportTest, ImportFileKeepsUnreadableUserFiles) {
+    const std::string directory = "ndjson_import_corrupt";
+    std::filesystem::create_directory(directory);
+    {
+        std::ofstream file(directory + "/frank.json");
+        file << "[{\"subject\": \"Art\", truncated";
+    }
+    {
+        std::ofstream file(directory + "/import.ndjson");
+        file << importLine("frank", "New", 5) << "\n";
+    }
+
+    auto result = NdjsonImport::importFile(directory + "/import.ndjson", directory);
+
+    EXPECT_EQ(result.unreadableUsers, std::vector<std::string>{"frank"});
+    std::ifstream file(directory + "/frank.json");
+    std::string kept((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(kept, "[{\"subject\": \"Art\", truncated");
+
+    std::filesystem::remove_all(directory);
+}
+
+// Test that importing merges into existing user files
+TEST(NdjsonImportTest, ImportFileMergesIntoUserFiles) {
+    const std::string directory = "ndjson_import_data";
+    std::filesystem::create_directory(directory);
+    Planner::saveToFile(directory + "/carol.json",
+                        {std::make_shared<Assignment>("Art", "Existing", 4, 1, 2.0f, 3, false, 1)});
+    {
+        std::ofstream file(directory + "/import.ndjson");
+        file << importLine("carol", "New", 5) << "\n" << importLine("dave", "First", 6) << "\n"
+             << importLine("../escape", "Bad", 7) << "\n";
+    }
+
+    auto result = NdjsonImport::importFile(directory + "/import.ndjson", directory);
+
+    EXPECT_EQ(result.rejectedUsers, std::vector<std::string>{"../escape"});
+    auto carol = Planner::loadFromFile(directory + "/carol.json");
+    ASSERT_EQ(carol.size(), 2);
+    EXPECT_EQ(carol[0]->getName(), "Existing");
+    EXPECT_EQ(carol[1]->getName(), "New");
+    EXPECT_NE(carol[0]->getId(), carol[1]->getId());
+    EXPECT_EQ(Planner::loadFromFile(directory + "/dave.json").size(), 1);
+
+    std::filesystem::remove_all(directory);
+}
+
+// Test that the line parser requires the user field and rejects it in array files
+TEST(NdjsonImportTest, UserFieldOnlyInLines) {
+    int calls = 0;
+    EXPECT_TRUE(AssignmentParser::parseLine(importLine("erin", "HW", 1), [&](const AssignmentParser::Record& record) {
+        EXPECT_EQ(record.user, "erin");
+        ++calls;
+    }));
+    EXPECT_EQ(calls, 1);
+    EXPECT_FALSE(AssignmentParser::parseArray("[" + importLine("erin", "HW", 1) + "]",
+                                              [](const AssignmentParser::Record&) {}));
+}
@@ -1,8 +1,10 @@
 #include "gtest/gtest.h"
 #include "../include/planner.hpp"
 #include "../include/assignment.hpp"
+#include "../include/icsschedule.hpp"
 #include "../include/json.hpp"
 #include <fstream>
+#include <iterator>
 #include <vector>
 #include <string>
 #include <memory>
@@ -68,6 +70,55 @@ TEST(PlannerTest, SaveToFile) {
     EXPECT_EQ(savedData.size(), 2);
     EXPECT_EQ(savedData[0]["subject"], "Math");
     EXPECT_EQ(savedData[1]["name"], "Science Project");
+    EXPECT_FALSE(savedData[0].contains("id"));
+
+    // Clean up
+    std::remove("temp.json");
+}
+
+// Test that both save styles match what nlohmann::json writes for the same data
+TEST(PlannerTest, SaveToFile_MatchesJsonDump) {
+    std::vector<Planner::AssignmentPtr> assignments = {
+        createAssignment("Math", "Quote \" and \\ and \t", 5, 10, 20.0, 1, false, 1),
+        createAssignment("Science", "Project", 7, 15, 2.5, 2, true, 3)
+    };
+    assignments[1]->setId(42);
+
+    auto readAll = [](const std::string& filename) {
+        std::ifstream file(filename);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    };
+
+    Planner::saveToFile("temp_pretty.json", assignments);
+    Planner::saveToFile("temp_compact.json", assignments, Planner::JsonStyle::Compact);
+    std::string pretty = readAll("temp_pretty.json");
+    std::string compact = readAll("temp_compact.json");
+
+    json expected = json::parse(pretty);
+    EXPECT_EQ(pretty, expected.dump(4));
+    EXPECT_EQ(compact, expected.dump());
+    EXPECT_EQ(expected[0]["weight"].dump(), "20.0");
+    EXPECT_EQ(expected[1]["id"], 42);
+
+    auto loaded = Planner::loadFromFile("temp_compact.json");
+    ASSERT_EQ(loaded.size(), 2);
+    EXPECT_EQ(loaded[0]->getName(), "Quote \" and \\ and \t");
+    EXPECT_FLOAT_EQ(loaded[1]->getWeight(), 2.5f);
+
+    std::remove("temp_pretty.json");
+    std::remove("temp_compact.json");
+}
+
+// Test that assignment ids survive a save and load round trip
+TEST(PlannerTest, SaveAndLoad_PreservesIds) {
+    auto assignment = createAssignment("Math", "Math Homework", 5, 10, 20.0, 1, false, 1);
+    assignment->setId(1234567890123ull);
+
+    Planner::saveToFile("temp.json", {assignment});
+    auto loaded = Planner::loadFromFile("temp.json");
+
+    ASSERT_EQ(loaded.size(), 1);
+    EXPECT_EQ(loaded[0]->getId(), 1234567890123ull);
 
     // Clean up
     std::remove("temp.json");
@@ -131,3 +182,131 @@ TEST(PlannerTest, Scheduler_Simple) {
     file.close();
     std::remove("Data/test_user_schedule.ics");
 }
+
+// Test that sub-hour slots inside a configured study window set the event times
+TEST(PlannerTest, Scheduler_StudyWindowSlots) {
+    std::vector<Planner::AssignmentPtr> assignments = {
+        createAssignment("Math", "Math Homework", 1, 2, 20.0, 1, false, 1)
+    };
+    if (!std::filesystem::exists("Data"))
+        std::filesystem::create_directory("Data");
+
+    StudyCalendar calendar(4, 4);
+    calendar.setSlotMinutes(30);
+    calendar.setStudyWindow(19 * 60 + 30, 3 * 60);
+    Planner::scheduler(assignments, calendar, "test_window_user");
+
+    std::ifstream file("Data/test_window_user_schedule.ics");
+    ASSERT_TRUE(file.is_open());
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    // The two hours form one block
+    EXPECT_NE(content.find("T193000\nDTEND:"), std::string::npos);
+    EXPECT_NE(content.find("T213000\nDESCRIPTION:"), std::string::npos);
+    EXPECT_EQ(content.find("T203000"), std::string::npos);
+
+    file.close();
+    std::remove("Data/test_window_user_schedule.ics");
+}
+
+// Test that a fixed base date makes the ICS output exact and byte-stable
+TEST(PlannerTest, Scheduler_FixedBaseDate) {
+    std::vector<Planner::AssignmentPtr> assignments = {
+        createAssignment("Math", "Math Homework", 3, 2, 20.0, 1, false, 1)
+    };
+    assignments[0]->setId(7);
+    if (!std::filesystem::exists("Data"))
+        std::filesystem::create_directory("Data");
+    std::remove("Data/test_fixed_user_schedule.ics");
+
+    auto run = [&assignments] {
+        Planner::scheduler(assignments, StudyCalendar(1, 1), "test_fixed_user", CivilDate{2026, 12, 30});
+        std::ifstream file("Data/test_fixed_user_schedule.ics");
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    };
+    std::string first = run();
+    EXPECT_EQ(first, run());
+    EXPECT_EQ(first,
+              "BEGIN:VCALENDAR\nVERSION:2.0\nPRODID:-//Planner App//EN\n"
+              "BEGIN:VEVENT\nUID:a7-s1@planner-app\nDTSTAMP:20261230T000000Z\nSEQUENCE:0\nSUMMARY:Math Homework\nDTSTART:20261231T180000\nDTEND:20261231T190000\n"
+              "RRULE:FREQ=DAILY;COUNT=2\nDESCRIPTION:Scheduled Assignment\nSTATUS:CONFIRMED\nEND:VEVENT\n"
+              "END:VCALENDAR\n");
+    std::remove("Data/test_fixed_user_schedule.ics");
+}
+
+// Test that event times past midnight roll over to the next date
+TEST(PlannerTest, AddToICSFile_PastMidnight) {
+    Planner::addToICSFile("test_midnight.ics", "Reading", CivilDate{2028, 2, 28}, 23 * 60 + 30, 24 * 60 + 60);
+
+    std::ifstream file("test_midnight.ics");
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find("DTSTART:20280228T233000\n"), std::string::npos);
+    EXPECT_NE(content.find("DTEND:20280301T003000\n"), std::string::npos);
+    file.close();
+    std::remove("test_midnight.ics");
+}
+
+// Test that appended sessions at the same time get distinct UIDs and every event is stamped
+TEST(PlannerTest, AddToICSFile_UniqueUids) {
+    std::remove("test_uids.ics");
+    Planner::addToICSFile("test_uids.ics", "Reading", CivilDate{2028, 2, 28}, 18 * 60, 60);
+    Planner::addToICSFile("test_uids.ics", "Essay", CivilDate{2028, 2, 28}, 18 * 60, 60);
+
+    std::ifstream file("test_uids.ics");
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::vector<IcsEvent> events = IcsSchedule::readEvents(content);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_NE(events[0].uid, events[1].uid);
+    EXPECT_EQ(events[0].uid.rfind("20280228T180000-", 0), 0u);
+
+    std::size_t stamps = 0;
+    for (std::size_t at = content.find("\nDTSTAMP:"); at != std::string::npos; at = content.find("\nDTSTAMP:", at + 1))
+        ++stamps;
+    EXPECT_EQ(stamps, 2u);
+    std::remove("test_uids.ics");
+}
+
+// Test the delta file written against the previous schedule
+TEST(PlannerTest, Scheduler_DeltaFile) {
+    std::vector<Planner::AssignmentPtr> assignments = {
+        createAssignment("Math", "Essay", 5, 3, 20.0, 1, false, 1),
+        createAssignment("Physics", "Lab Report", 5, 1, 10.0, 3, false, 1)
+    };
+    assignments[0]->setId(1);
+    assignments[1]->setId(2);
+    if (!std::filesystem::exists("Data"))
+        std::filesystem::create_directory("Data");
+    std::remove("Data/test_delta_user_schedule.ics");
+
+    Planner::IcsOptions expanded;
+    expanded.writeDelta = true;
+    expanded.compressRecurring = false;
+    auto readDelta = [] {
+        std::ifstream file("Data/test_delta_user_schedule_delta.ics");
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    };
+
+    // First run: everything is new
+    Planner::scheduler(assignments, StudyCalendar(2, 2), "test_delta_user", CivilDate{2026, 10, 18}, expanded);
+    std::string first = readDelta();
+    EXPECT_NE(first.find("METHOD:PUBLISH"), std::string::npos);
+    EXPECT_EQ(first.find("METHOD:CANCEL"), std::string::npos);
+    EXPECT_NE(first.find("UID:a1-s3@planner-app"), std::string::npos);
+
+    // Unchanged schedule: empty delta
+    Planner::scheduler(assignments, StudyCalendar(2, 2), "test_delta_user", CivilDate{2026, 10, 18}, expanded);
+    EXPECT_TRUE(readDelta().empty());
+
+    // Dropping the lab report cancels its session and moves the essay's third hour
+    std::vector<Planner::AssignmentPtr> remaining = {assignments[0]};
+    Planner::scheduler(remaining, StudyCalendar(2, 2), "test_delta_user", CivilDate{2026, 10, 18}, expanded);
+    std::string delta = readDelta();
+    std::size_t cancel = delta.find("METHOD:CANCEL");
+    ASSERT_NE(cancel, std::string::npos);
+    EXPECT_NE(delta.find("UID:a2-s1@planner-app", cancel), std::string::npos);
+    EXPECT_NE(delta.find("STATUS:CANCELLED", cancel), std::string::npos);
+    EXPECT_EQ(delta.find("UID:a1-s1@planner-app"), std::string::npos);
+
+    std::remove("Data/test_delta_user_schedule.ics");
+    std::remove("Data/test_delta_user_schedule_delta.ics");
+}
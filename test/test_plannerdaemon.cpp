@@ -0,0 +1,263 @@
+#include "gtest/gtest.h"
+#include "../include/plannerdaemon.hpp"
+#include "../include/json.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <chrono>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+// Daemon tests work on their own user file under Data/
+class PlannerDaemonTest : public ::testing::Test {
+protected:
+    const std::string user = "daemon_test_user";
+
+    void SetUp() override {
+        std::filesystem::create_directory("Data");
+        std::remove(("Data/" + user + ".json").c_str());
+    }
+
+    void TearDown() override {
+        std::remove(("Data/" + user + ".json").c_str());
+    }
+
+    json call(PlannerDaemon& daemon, const std::string& method, json params) {
+        params["user"] = user;
+        json request = {{"jsonrpc", "2.0"}, {"id", 7}, {"method", method}, {"params", params}};
+        return json::parse(daemon.handleRequest(request.dump()));
+    }
+};
+
+// Test add, list and delete round trips and persistence
+TEST_F(PlannerDaemonTest, AddListDelete) {
+    PlannerDaemon daemon;
+
+    json added = call(daemon, "add", {{"subject", "Math"}, {"name", "Homework"}, {"deadline", 3},
+                                      {"duration", 4}, {"weight", 20.0}, {"size", 1}});
+    EXPECT_EQ(added["id"], 7);
+    AssignmentId homework = added["result"]["id"];
+    json mural = call(daemon, "add", {{"subject", "Art"}, {"name", "Mural"}, {"deadline", 9},
+                                      {"duration", 8}, {"weight", 10.0}, {"size", 2}, {"group_size", 2}});
+    EXPECT_NE(mural["result"]["id"], homework);
+
+    json listed = call(daemon, "list", json::object());
+    ASSERT_EQ(listed["result"].size(), 2);
+    EXPECT_EQ(listed["result"][1]["name"], "Mural");
+    EXPECT_EQ(listed["result"][1]["group_work"], true);
+
+    call(daemon, "update", {{"id", mural["result"]["id"]}, {"deadline", 4}});
+    call(daemon, "delete", {{"id", homework}});
+    daemon.flush();
+
+    // A fresh daemon reads the saved file
+    PlannerDaemon restarted;
+    listed = call(restarted, "list", json::object());
+    ASSERT_EQ(listed["result"].size(), 1);
+    EXPECT_EQ(listed["result"][0]["name"], "Mural");
+    EXPECT_EQ(listed["result"][0]["deadline"], 4);
+    EXPECT_EQ(listed["result"][0]["group_size"], 2);
+    EXPECT_EQ(listed["result"][0]["id"], mural["result"]["id"]);
+}
+
+// Test the schedule method
+TEST_F(PlannerDaemonTest, Schedule) {
+    PlannerDaemon daemon;
+    call(daemon, "add", {{"subject", "Math"}, {"name", "Homework"}, {"deadline", 4},
+                         {"duration", 2}, {"weight", 20.0}, {"size", 1}});
+
+    json scheduled = call(daemon, "schedule", {{"weekday_hours", 3}, {"weekend_hours", 5}});
+
+    ASSERT_EQ(scheduled["result"]["slots"].size(), 2);
+    EXPECT_EQ(scheduled["result"]["slots"][0]["name"], "Homework");
+    EXPECT_TRUE(scheduled["result"]["missed"].empty());
+
+    // From Friday 2026-10-16 without weekend hours, work starts on Monday
+    json pinned = call(daemon, "schedule", {{"weekday_hours", 3}, {"weekend_hours", 0}, {"base_date", "2026-10-16"}});
+    ASSERT_EQ(pinned["result"]["slots"].size(), 2);
+    EXPECT_EQ(pinned["result"]["slots"][0]["day"], 3);
+    EXPECT_EQ(call(daemon, "schedule", {{"weekday_hours", 3}, {"weekend_hours", 0}, {"base_date", "soon"}})["error"]["code"], -32602);
+}
+
+// Test that schedule, like export_ics, places no more hours a day than the study window holds
+TEST_F(PlannerDaemonTest, ScheduleKeepsToStudyWindow) {
+    PlannerDaemon daemon;
+    call(daemon, "add", {{"subject", "Math"}, {"name", "Thesis"}, {"deadline", 3},
+                         {"duration", 100}, {"weight", 20.0}, {"size", 1}});
+
+    json scheduled = call(daemon, "schedule", {{"weekday_hours", 30}, {"weekend_hours", 30}, {"base_date", "2026-10-16"}});
+
+    const json& slots = scheduled["result"]["slots"];
+    ASSERT_EQ(slots.size(), 72);
+    EXPECT_EQ(slots[23]["day"], 1);
+    EXPECT_EQ(slots[24]["day"], 2);
+}
+
+// Test exporting the schedule as CSV
+TEST_F(PlannerDaemonTest, ExportSchedule) {
+    PlannerDaemon daemon;
+    call(daemon, "add", {{"subject", "Math"}, {"name", "Homework"}, {"deadline", 4},
+                         {"duration", 2}, {"weight", 20.0}, {"size", 1}});
+
+    json exported = call(daemon, "export_schedule", {{"weekday_hours", 1}, {"weekend_hours", 1},
+                                                     {"base_date", "2026-10-16"}, {"format", "csv"}});
+    const std::string path = "Data/" + user + "_schedule.csv";
+    ASSERT_EQ(exported["result"]["path"], path);
+    std::ifstream file(path);
+    std::string header, first;
+    std::getline(file, header);
+    std::getline(file, first);
+    EXPECT_EQ(header, "kind,date,start,end,subject,name,id");
+    EXPECT_EQ(first.rfind("session,2026-10-17,2026-10-17T18:00,2026-10-17T19:00,Math,Homework,", 0), 0u);
+    file.close();
+    std::remove(path.c_str());
+
+    EXPECT_EQ(call(daemon, "export_schedule", {{"weekday_hours", 1}, {"weekend_hours", 1}, {"format", "xml"}})["error"]["code"], -32602);
+    for (const char* format : {"ics", "null"}) {
+        EXPECT_EQ(call(daemon, "export_schedule", {{"weekday_hours", 1}, {"weekend_hours", 1}, {"format", format}})["error"]["code"], -32602);
+    }
+    EXPECT_FALSE(std::filesystem::exists("Data/" + user + "_schedule."));
+}
+
+// Test that out-of-range assignment fields are rejected instead of reaching the Assignment
+TEST_F(PlannerDaemonTest, RejectsInvalidFields) {
+    PlannerDaemon daemon;
+    const json valid = {{"subject", "Math"}, {"name", "Homework"}, {"deadline", 4},
+                        {"duration", 2}, {"weight", 20.0}, {"size", 1}};
+    auto with = [&valid](const char* key, json value) {
+        json params = valid;
+        params[key] = value;
+        return params;
+    };
+
+    EXPECT_EQ(call(daemon, "add", with("group_size", 0))["error"]["code"], -32602);
+    EXPECT_EQ(call(daemon, "add", with("group_size", -3))["error"]["code"], -32602);
+    EXPECT_EQ(call(daemon, "add", with("deadline", -1))["error"]["code"], -32602);
+    EXPECT_EQ(call(daemon, "add", with("deadline", 1000000))["error"]["code"], -32602);
+    EXPECT_EQ(call(daemon, "add", with("duration", -2))["error"]["code"], -32602);
+    EXPECT_EQ(call(daemon, "add", with("duration", 2000000000))["error"]["code"], -32602);
+    EXPECT_EQ(call(daemon, "add", with("size", -1))["error"]["code"], -32602);
+    EXPECT_EQ(call(daemon, "add", with("size", 1000000))["error"]["code"], -32602);
+
+    // Updates are checked the same way and leave the stored assignment alone
+    AssignmentId id = call(daemon, "add", valid)["result"]["id"].get<AssignmentId>();
+    EXPECT_EQ(call(daemon, "update", {{"id", id}, {"group_size", 0}})["error"]["code"], -32602);
+    json listed = call(daemon, "list", json::object());
+    ASSERT_EQ(listed["result"].size(), 1);
+    EXPECT_EQ(listed["result"][0]["group_size"], 1);
+}
+
+// Test JSON-RPC error responses
+TEST_F(PlannerDaemonTest, Errors) {
+    PlannerDaemon daemon;
+
+    EXPECT_EQ(json::parse(daemon.handleRequest("{not json"))["error"]["code"], -32700);
+    EXPECT_EQ(call(daemon, "frobnicate", json::object())["error"]["code"], -32601);
+    EXPECT_EQ(call(daemon, "delete", {{"id", 99}})["error"]["code"], -32602);
+    EXPECT_EQ(call(daemon, "add", {{"subject", "Math"}})["error"]["code"], -32602);
+
+    json traversal = {{"jsonrpc", "2.0"}, {"id", 1}, {"method", "list"}, {"params", {{"user", "../secret"}}}};
+    EXPECT_EQ(json::parse(daemon.handleRequest(traversal.dump()))["error"]["code"], -32602);
+}
+
+#ifndef _WIN32
+// Connect to a daemon socket, retrying while the server starts; -1 on failure
+static int connectToDaemon(const std::string& socketPath) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", socketPath.c_str());
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0)
+            return fd;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ::close(fd);
+    return -1;
+}
+
+// Test a request over the Unix domain socket
+TEST_F(PlannerDaemonTest, SocketRoundTrip) {
+    const std::string socketPath = "daemon_test.sock";
+    PlannerDaemon daemon;
+    std::thread server([&] { daemon.serve(socketPath); });
+
+    int fd = connectToDaemon(socketPath);
+    ASSERT_GE(fd, 0);
+
+    std::string request = "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"list\",\"params\":{\"user\":\"" + user + "\"}}\n"
+                          "{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"shutdown\"}\n";
+    ::send(fd, request.data(), request.size(), 0);
+
+    std::string received;
+    char chunk[1024];
+    ssize_t n;
+    while ((n = ::recv(fd, chunk, sizeof(chunk), 0)) > 0)
+        received.append(chunk, static_cast<std::size_t>(n));
+    ::close(fd);
+    server.join();
+
+    auto firstLine = received.substr(0, received.find('\n'));
+    json response = json::parse(firstLine);
+    EXPECT_EQ(response["id"], 1);
+    EXPECT_TRUE(response["result"].is_array());
+    EXPECT_FALSE(std::filesystem::exists(socketPath));
+}
+
+// Test that a client which never reads, or sends an endless line, does not hold up other clients
+TEST_F(PlannerDaemonTest, SlowClientsDoNotStallOthers) {
+    const std::string socketPath = "daemon_test_slow.sock";
+    PlannerDaemon daemon;
+    std::thread server([&] { daemon.serve(socketPath); });
+
+    // Queue far more responses than the socket buffer holds, and never read them
+    int stalled = connectToDaemon(socketPath);
+    ASSERT_GE(stalled, 0);
+    ::fcntl(stalled, F_SETFL, ::fcntl(stalled, F_GETFL) | O_NONBLOCK);
+    const std::string list = "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"stats\"}\n";
+    std::string requests;
+    for (int i = 0; i < 20000; ++i)
+        requests += list;
+    std::size_t sent = 0;
+    for (int attempt = 0; attempt < 200 && sent < requests.size(); ++attempt) {
+        ssize_t n = ::send(stalled, requests.data() + sent, requests.size() - sent, MSG_NOSIGNAL);
+        if (n > 0)
+            sent += static_cast<std::size_t>(n);
+        else
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    // A request line over the limit gets the client dropped
+    int flooding = connectToDaemon(socketPath);
+    ASSERT_GE(flooding, 0);
+    std::string endless(2 * 1024 * 1024, 'x');
+    ::send(flooding, endless.data(), endless.size(), MSG_NOSIGNAL);
+    char chunk[1024];
+    EXPECT_LE(::recv(flooding, chunk, sizeof(chunk), 0), 0);
+    ::close(flooding);
+
+    // Another client is still answered
+    int fd = connectToDaemon(socketPath);
+    ASSERT_GE(fd, 0);
+    std::string request = "{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"shutdown\"}\n";
+    ::send(fd, request.data(), request.size(), 0);
+    std::string received;
+    ssize_t n;
+    while ((n = ::recv(fd, chunk, sizeof(chunk), 0)) > 0)
+        received.append(chunk, static_cast<std::size_t>(n));
+    ::close(fd);
+    ::close(stalled);
+    server.join();
+
+    EXPECT_EQ(json::parse(received.substr(0, received.find('\n')))["id"], 2);
+}
+#endif
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+#include "../include/priorityrules.hpp"
+#include "../include/scheduleengine.hpp"
+#include "../include/planner.hpp"
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Test that the default tables agree with the original branches over the interesting ranges
+TEST(PriorityRulesTest, DefaultsMatchReference) {
+    const PriorityRules rules;
+    const std::vector<float> weights = {-1.0f, 0.0f, 9.5f, 10.0f, 10.01f, 15.0f, 15.5f, 20.0f, 20.001f, 100.0f,
+                                        std::numeric_limits<float>::quiet_NaN()};
+
+    for (int deadline = -3; deadline <= 12; ++deadline)
+        for (int duration = -2; duration <= 40; ++duration)
+            for (int hours = -1; hours <= 8; ++hours)
+                for (float weight : weights)
+                    for (int size = -1; size <= 5; ++size)
+                        ASSERT_EQ(rules.score(deadline, duration, weight, size, hours),
+                                  Planner::referencePriority(deadline, duration, weight, size, hours))
+                            << deadline << " " << duration << " " << weight << " " << size << " " << hours;
+}
+
+// Test a custom policy with mixed comparisons and a missing factor
+TEST(PriorityRulesTest, CustomPolicy) {
+    PriorityRules rules = PriorityRules::fromJson(R"({
+        "deadline": [{"equals": 0, "points": 50}, {"below": 3, "points": 5}, {"above": 30, "points": -5}],
+        "weight":   [{"above": 50, "points": 9}, {"above": 2.5, "points": 1}]
+    })");
+
+    EXPECT_EQ(rules.score(0, 1, 0.0f, 1, 4), 50);
+    EXPECT_EQ(rules.score(-7, 1, 0.0f, 1, 4), 5);
+    EXPECT_EQ(rules.score(10, 1, 2.5f, 1, 4), 0);
+    EXPECT_EQ(rules.score(10, 1, 2.6f, 1, 4), 1);
+    EXPECT_EQ(rules.score(1000, 1, 60.0f, 1, 4), 4);
+}
+
+// Test that malformed policies are rejected
+TEST(PriorityRulesTest, RejectsMalformedPolicies) {
+    EXPECT_THROW(PriorityRules::fromJson("[1, 2]"), std::invalid_argument);
+    EXPECT_THROW(PriorityRules::fromJson(R"({"urgency": []})"), std::invalid_argument);
+    EXPECT_THROW(PriorityRules::fromJson(R"({"deadline": [{"below": 2}]})"), std::invalid_argument);
+    EXPECT_THROW(PriorityRules::fromJson(R"({"deadline": [{"below": 2.5, "points": 1}]})"), std::invalid_argument);
+    EXPECT_THROW(PriorityRules::fromJson(R"({"weight": [{"below": 2, "points": 1}]})"), std::invalid_argument);
+    EXPECT_THROW(PriorityRules::fromJson(R"({"size": [{"equals": 100000000, "points": 1}]})"), std::invalid_argument);
+}
+
+// Test that the active rules drive Planner::calculatePriority
+TEST(PriorityRulesTest, ActiveRulesUsedByPlanner) {
+    EXPECT_EQ(Planner::calculatePriority(1, 3, 25.0f, 1, 2), Planner::referencePriority(1, 3, 25.0f, 1, 2));
+
+    PriorityRules::setActive(PriorityRules::fromJson(R"({"size": [{"equals": 1, "points": 100}]})"));
+    EXPECT_EQ(Planner::calculatePriority(1, 3, 25.0f, 1, 2), 100);
+
+    PriorityRules::setActive(PriorityRules());
+    EXPECT_EQ(Planner::calculatePriority(1, 3, 25.0f, 1, 2), Planner::referencePriority(1, 3, 25.0f, 1, 2));
+}
+
+// Test that the score really stays constant for the promised number of days, whatever the daily hours
+TEST(PriorityRulesTest, StableDaysIsConservative) {
+    const PriorityRules rules;
+    for (int deadline = 1; deadline <= 30; ++deadline)
+        for (int duration = -2; duration <= 60; duration += 3)
+            for (int minHours = 0; minHours <= 6; ++minHours)
+                for (int maxHours = minHours; maxHours <= minHours + 4; ++maxHours)
+                    for (int today = minHours; today <= maxHours; ++today) {
+                        int score = rules.score(deadline, duration, 12.0f, 2, today);
+                        int stable = rules.stableDays(deadline, duration, today, minHours, maxHours);
+                        ASSERT_LT(stable, deadline);
+                        for (int t = 1; t <= stable; ++t)
+                            for (int hours = minHours; hours <= maxHours; ++hours)
+                                ASSERT_EQ(rules.score(deadline - t, duration, 12.0f, 2, hours), score)
+                                    << deadline << " " << duration << " " << today << " t=" << t << " h=" << hours;
+                    }
+}
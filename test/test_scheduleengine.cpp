@@ -0,0 +1,170 @@
+#include "gtest/gtest.h"
+#include "../include/scheduleengine.hpp"
+#include "../include/assignment.hpp"
+#include "../include/priorityrules.hpp"
+#include "scheduler_differential.hpp"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+static std::shared_ptr<Assignment> createAssignment(const std::string& subject, const std::string& name, int deadline,
+                                                    int duration, float weight, int size, bool groupWork, int groupSize) {
+    return std::make_shared<Assignment>(subject, name, deadline, duration, weight, size, groupWork, groupSize);
+}
+
+// Test Planner::computeSchedule on a small hand-checked case
+TEST(ScheduleEngineTest, ComputeSchedule_Simple) {
+    std::vector<Planner::AssignmentPtr> assignments = {
+        createAssignment("Math", "Math Homework", 2, 2, 20.0, 1, false, 1)
+    };
+
+    Planner::ScheduleResult schedule = Planner::computeSchedule(assignments, 3, 5);
+
+    ASSERT_EQ(schedule.slots.size(), 2);
+    EXPECT_EQ(schedule.slots[0].day, 1);
+    EXPECT_EQ(schedule.slots[0].hour, 0);
+    EXPECT_EQ(schedule.slots[1].hour, 1);
+    EXPECT_TRUE(schedule.missed.empty());
+    EXPECT_EQ(schedule.days, 1);
+}
+
+// Test that computeSchedule reports missed deadlines and leaves its input untouched
+TEST(ScheduleEngineTest, ComputeSchedule_MissedDeadline) {
+    std::vector<Planner::AssignmentPtr> assignments = {
+        createAssignment("Math", "Math Homework", 1, 10, 20.0, 1, false, 1)
+    };
+
+    Planner::ScheduleResult schedule = Planner::computeSchedule(assignments, 3, 5);
+
+    EXPECT_EQ(schedule.slots.size(), 3);
+    ASSERT_EQ(schedule.missed.size(), 1);
+    EXPECT_EQ(schedule.missed[0].day, 1);
+    EXPECT_EQ(schedule.missed[0].assignment, 0);
+    EXPECT_EQ(assignments[0]->getDeadline(), 1);
+    EXPECT_EQ(assignments[0]->getRealDuration(), 10);
+}
+
+// Differential test: the engine must reproduce the reference scheduler slot for slot
+TEST(ScheduleEngineTest, MatchesReferenceOnRandomInputs) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<std::uint8_t> input(3 + SchedulerDifferential::kBytesPerAssignment * 48);
+
+    // Assignment lifecycle tracing would flood the test log
+    std::ostringstream discard;
+    std::streambuf* original = std::cout.rdbuf(discard.rdbuf());
+
+    std::string diff;
+    for (int n = 0; n < 500 && diff.empty(); ++n) {
+        for (auto& b : input)
+            b = static_cast<std::uint8_t>(byte(rng));
+        diff = SchedulerDifferential::compare(SchedulerDifferential::decode(input.data(), input.size()));
+        discard.str("");
+    }
+
+    std::cout.rdbuf(original);
+    EXPECT_TRUE(diff.empty()) << diff;
+}
+
+// Differential test with a policy whose slack and deadline runs differ from the defaults,
+// exercising the kinetic rescoring bounds on long horizons
+TEST(ScheduleEngineTest, MatchesReferenceWithCustomRules) {
+    PriorityRules::setActive(PriorityRules::fromJson(R"({
+        "deadline": [{"below": 3, "points": 12}, {"below": 10, "points": 7}, {"below": 25, "points": 3}, {"above": 40, "points": -2}],
+        "slack":    [{"below": 0, "points": 40}, {"below": 5, "points": 18}, {"below": 30, "points": 9}, {"below": 90, "points": 2}, {"above": 150, "points": -4}],
+        "weight":   [{"above": 30, "points": 5}, {"above": 5, "points": 1}],
+        "size":     [{"equals": 2, "points": 4}]
+    })"));
+
+    std::mt19937 rng(777);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<std::uint8_t> input(3 + SchedulerDifferential::kBytesPerAssignment * 48);
+
+    std::ostringstream discard;
+    std::streambuf* original = std::cout.rdbuf(discard.rdbuf());
+
+    std::string diff;
+    for (int n = 0; n < 300 && diff.empty(); ++n) {
+        for (auto& b : input)
+            b = static_cast<std::uint8_t>(byte(rng));
+        diff = SchedulerDifferential::compare(SchedulerDifferential::decode(input.data(), input.size()));
+        discard.str("");
+    }
+
+    std::cout.rdbuf(original);
+    PriorityRules::setActive(PriorityRules());
+    EXPECT_TRUE(diff.empty()) << diff;
+}
+
+// Differential test with calendar capacity: holidays, uneven days and horizons shorter than the deadlines
+TEST(ScheduleEngineTest, MatchesReferenceWithDayCapacity) {
+    std::mt19937 rng(4242);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> hours(-1, 9);
+    std::uniform_int_distribution<int> length(0, 50);
+    std::vector<std::uint8_t> input(3 + SchedulerDifferential::kBytesPerAssignment * 48);
+
+    std::ostringstream discard;
+    std::streambuf* original = std::cout.rdbuf(discard.rdbuf());
+
+    std::string diff;
+    for (int n = 0; n < 400 && diff.empty(); ++n) {
+        for (auto& b : input)
+            b = static_cast<std::uint8_t>(byte(rng));
+        Planner::DayCapacity capacity(static_cast<std::size_t>(length(rng)));
+        for (auto& day : capacity)
+            day = n % 4 == 0 ? hours(rng) : std::max(0, hours(rng)); // Negative hours only occasionally
+        diff = SchedulerDifferential::compare(SchedulerDifferential::decode(input.data(), input.size()), capacity);
+        discard.str("");
+    }
+
+    std::cout.rdbuf(original);
+    EXPECT_TRUE(diff.empty()) << diff;
+}
+
+// Test that a capacity vector built with the legacy rule reproduces the weekday/weekend overload
+TEST(ScheduleEngineTest, LegacyCapacityMatchesWeekdayWeekendOverload) {
+    std::vector<Planner::AssignmentPtr> assignments = {
+        createAssignment("Math", "Essay", 9, 14, 25.0, 2, false, 1),
+        createAssignment("Physics", "Lab", 4, 5, 12.0, 1, true, 3),
+        createAssignment("History", "Reading", 12, 20, 8.0, 3, false, 1)
+    };
+
+    Planner::DayCapacity capacity;
+    for (int day = 1; day <= Planner::scheduleHorizon(assignments); ++day)
+        capacity.push_back(Planner::studyHoursForDay(day, 2, 4));
+
+    EXPECT_EQ(Planner::scheduleHorizon(assignments), 12);
+    EXPECT_TRUE(SchedulerDifferential::describe(Planner::computeSchedule(assignments, 2, 4),
+                                                Planner::computeSchedule(assignments, capacity)).empty());
+}
+
+// Test that equal priorities are taken in the original std::priority_queue order, not in list order
+TEST(ScheduleEngineTest, EqualPrioritiesKeepPriorityQueueOrder) {
+    auto makeAssignments = [] {
+        std::vector<Planner::AssignmentPtr> assignments;
+        for (int i = 0; i < 6; ++i)
+            assignments.push_back(createAssignment("Math", "Task " + std::to_string(i), 20, 3, 5.0, 4, false, 1));
+        return assignments;
+    };
+    const std::vector<std::size_t> expected = {0, 2, 0, 2, 0, 2, 1, 4, 1, 4, 1, 4, 3, 5, 3, 5, 3, 5};
+
+    std::vector<Planner::AssignmentPtr> assignments = makeAssignments();
+    Planner::ScheduleResult schedule = Planner::computeSchedule(assignments, 2, 2);
+    std::vector<std::size_t> order;
+    for (const auto& slot : schedule.slots)
+        order.push_back(slot.assignment);
+    EXPECT_EQ(order, expected);
+
+    std::ostringstream discard;
+    std::streambuf* original = std::cout.rdbuf(discard.rdbuf());
+    Planner::ScheduleResult reference = Planner::referenceSchedule(makeAssignments(), 2, 2);
+    std::cout.rdbuf(original);
+    order.clear();
+    for (const auto& slot : reference.slots)
+        order.push_back(slot.assignment);
+    EXPECT_EQ(order, expected);
+}
@@ -0,0 +1,215 @@
+#include "gtest/gtest.h"
+#include "../include/schedulesink.hpp"
+#include "../include/busycalendar.hpp"
+#include "../include/planner.hpp"
+#include "../include/json.hpp"
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+// Keeps every call as a line of text
+class RecordingSink : public ScheduleSink {
+public:
+    std::vector<std::string> calls;
+
+    void begin(const Assignments& assignments, const CivilDate& baseDate) override {
+        calls.push_back("begin " + std::to_string(assignments.size()) + " " + baseDate.toString());
+    }
+    void day(int day) override { calls.push_back("day " + std::to_string(day)); }
+    void session(const ScheduledSession& s) override {
+        calls.push_back("session " + std::to_string(s.assignment) + " " + std::to_string(s.day) + " " + std::to_string(s.hour) + " " +
+                        std::to_string(s.startMinute) + "-" + std::to_string(s.endMinute));
+    }
+    void missed(const MissedDeadline& m) override {
+        calls.push_back("missed " + std::to_string(m.assignment) + " " + std::to_string(m.day));
+    }
+    void finish() override { calls.push_back("finish"); }
+};
+
+static std::vector<std::shared_ptr<Assignment>> sampleAssignments() {
+    std::vector<std::shared_ptr<Assignment>> assignments = {
+        std::make_shared<Assignment>("Math", "Homework", 3, 2, 20.0f, 1, false, 1),
+        std::make_shared<Assignment>("English", "Essay, \"final\"", 5, 4, 30.0f, 1, false, 1)
+    };
+    assignments[0]->setId(7);
+    assignments[1]->setId(12);
+    return assignments;
+}
+
+// Feed the same records to a sink: two sessions on day 1 (the second past midnight) and a missed deadline on day 2
+static void feedSample(ScheduleSink& sink, const ScheduleSink::Assignments& assignments) {
+    sink.begin(assignments, CivilDate{2026, 12, 30});
+    sink.day(1);
+    sink.session({0, 1, 0, 18 * 60, 19 * 60});
+    sink.session({1, 1, 1, 23 * 60 + 30, 24 * 60 + 30});
+    sink.day(2);
+    sink.missed({1, 2});
+    sink.finish();
+}
+
+// Test that the scheduler emits days, sessions and the end of the schedule in order
+TEST(ScheduleSinkTest, EmitScheduleOrder) {
+    auto assignments = sampleAssignments();
+    assignments.pop_back();
+    RecordingSink sink;
+    Planner::emitSchedule(assignments, StudyCalendar(1, 1), CivilDate{2026, 12, 30}, sink);
+
+    ASSERT_GE(sink.calls.size(), 6u);
+    EXPECT_EQ(sink.calls[0], "begin 1 2026-12-30");
+    EXPECT_EQ(sink.calls[1], "day 1");
+    EXPECT_EQ(sink.calls[2], "session 0 1 0 1080-1140");
+    EXPECT_EQ(sink.calls[3], "day 2");
+    EXPECT_EQ(sink.calls[4], "session 0 2 0 1080-1140");
+    EXPECT_EQ(sink.calls.back(), "finish");
+}
+
+// Test that an hour split around a busy time arrives as several sessions of the same hour
+TEST(ScheduleSinkTest, EmitScheduleSplitsAroundBusyTimes) {
+    auto assignments = sampleAssignments();
+    assignments.pop_back();
+    StudyCalendar calendar(1, 1);
+    calendar.setSlotMinutes(30);
+    calendar.setBusyTimes(BusyCalendar::parse("BEGIN:VCALENDAR\nBEGIN:VEVENT\nDTSTART:20261231T183000\n"
+                                              "DTEND:20261231T190000\nEND:VEVENT\nEND:VCALENDAR\n", 0));
+    RecordingSink sink;
+    Planner::emitSchedule(assignments, calendar, CivilDate{2026, 12, 30}, sink);
+
+    ASSERT_GE(sink.calls.size(), 4u);
+    EXPECT_EQ(sink.calls[2], "session 0 1 0 1080-1110");
+    EXPECT_EQ(sink.calls[3], "session 0 1 0 1140-1170");
+}
+
+// Test that the null sink only counts and the tee forwards every call
+TEST(ScheduleSinkTest, NullAndTee) {
+    auto assignments = sampleAssignments();
+    NullScheduleSink null;
+    RecordingSink recording;
+    TeeScheduleSink tee({&null, &recording});
+    feedSample(tee, assignments);
+
+    EXPECT_EQ(null.sessions(), 2u);
+    EXPECT_EQ(null.missedDeadlines(), 1u);
+    EXPECT_EQ(recording.calls.size(), 7u);
+    EXPECT_EQ(recording.calls[3], "session 1 1 1 1410-1470");
+}
+
+// Test the CSV rows, including quoting and times past midnight
+TEST(ScheduleSinkTest, CsvRows) {
+    auto assignments = sampleAssignments();
+    std::ostringstream out;
+    CsvScheduleSink sink(out);
+    feedSample(sink, assignments);
+
+    EXPECT_EQ(out.str(),
+              "kind,date,start,end,subject,name,id\n"
+              "session,2026-12-31,2026-12-31T18:00,2026-12-31T19:00,Math,Homework,7\n"
+              "session,2026-12-31,2026-12-31T23:30,2027-01-01T00:30,English,\"Essay, \"\"final\"\"\",12\n"
+              "missed,2027-01-01,,,English,\"Essay, \"\"final\"\"\",12\n");
+}
+
+// Test that dates outside four-digit years are refused instead of written as garbage
+TEST(ScheduleSinkTest, CsvRejectsYearsOutOfRange) {
+    auto assignments = sampleAssignments();
+    std::ostringstream out;
+    CsvScheduleSink sink(out);
+    sink.begin(assignments, CivilDate{-5, 1, 1});
+    EXPECT_THROW(sink.session({0, 1, 0, 18 * 60, 19 * 60}), std::out_of_range);
+
+    CsvScheduleSink late(out);
+    late.begin(assignments, CivilDate{9999, 12, 30});
+    EXPECT_THROW(late.missed({0, 2}), std::out_of_range);
+}
+
+// Test that every NDJSON line is a JSON object with the record's fields
+TEST(ScheduleSinkTest, NdjsonLines) {
+    auto assignments = sampleAssignments();
+    std::ostringstream out;
+    NdjsonScheduleSink sink(out);
+    feedSample(sink, assignments);
+
+    std::istringstream lines(out.str());
+    std::vector<json> records;
+    for (std::string line; std::getline(lines, line);)
+        records.push_back(json::parse(line));
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0]["kind"], "session");
+    EXPECT_EQ(records[0]["start"], "2026-12-31T18:00");
+    EXPECT_EQ(records[0]["id"], 7);
+    EXPECT_EQ(records[1]["name"], "Essay, \"final\"");
+    EXPECT_EQ(records[1]["end"], "2027-01-01T00:30");
+    EXPECT_EQ(records[1]["hour"], 1);
+    EXPECT_EQ(records[2]["kind"], "missed");
+    EXPECT_EQ(records[2]["date"], "2027-01-01");
+    EXPECT_FALSE(records[2].contains("start"));
+}
+
+// Test that the binary timeline reads back record for record
+TEST(ScheduleSinkTest, BinaryRoundTrip) {
+    auto assignments = sampleAssignments();
+    std::ostringstream out;
+    BinaryScheduleSink sink(out);
+    feedSample(sink, assignments);
+
+    std::string data = out.str();
+    ASSERT_EQ(data.size(), BinaryScheduleSink::HeaderSize + 3 * BinaryScheduleSink::RecordSize);
+    CivilDate baseDate;
+    std::vector<TimelineRecord> records = BinaryScheduleSink::read(data, &baseDate);
+    EXPECT_EQ(baseDate, (CivilDate{2026, 12, 30}));
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[1].kind, TimelineRecord::Session);
+    EXPECT_EQ(records[1].hour, 1);
+    EXPECT_EQ(records[1].day, 1);
+    EXPECT_EQ(records[1].startMinute, 23 * 60 + 30);
+    EXPECT_EQ(records[1].endMinute, 24 * 60 + 30);
+    EXPECT_EQ(records[1].id, 12u);
+    EXPECT_EQ(records[2].kind, TimelineRecord::Missed);
+    EXPECT_EQ(records[2].day, 2);
+
+    EXPECT_THROW(BinaryScheduleSink::read(data.substr(0, data.size() - 1)), std::invalid_argument);
+    EXPECT_THROW(BinaryScheduleSink::read("ICAL" + data.substr(4)), std::invalid_argument);
+
+    // Values wider than their fields are refused rather than truncated
+    std::ostringstream overflow;
+    BinaryScheduleSink narrow(overflow);
+    narrow.begin(assignments, CivilDate{2026, 12, 30});
+    EXPECT_THROW(narrow.missed({0, 70000}), std::out_of_range);
+    EXPECT_THROW(narrow.session({0, 1, 300, 18 * 60, 19 * 60}), std::out_of_range);
+    EXPECT_THROW(narrow.session({0, -1, 0, 18 * 60, 19 * 60}), std::out_of_range);
+}
+
+// Test that the ICS sink writes the same calendar as building the events directly
+TEST(ScheduleSinkTest, IcsMatchesBuiltEvents) {
+    auto assignments = sampleAssignments();
+    std::ostringstream out;
+    IcsScheduleSink sink(out, true);
+    feedSample(sink, assignments);
+
+    std::vector<IcsSession> sessions = {{0, 1, 18 * 60, 19 * 60}, {1, 1, 23 * 60 + 30, 24 * 60 + 30}};
+    std::vector<IcsEvent> events = IcsSchedule::buildEvents(sessions, assignments, CivilDate{2026, 12, 30}, true);
+    std::ostringstream expected;
+    {
+        OutputBuffer buffer(expected);
+        IcsSchedule::writeCalendar(buffer, events, CivilDate{2026, 12, 30});
+    }
+    EXPECT_EQ(out.str(), expected.str());
+    EXPECT_EQ(sink.delta().published.size(), 2u);
+}
+
+// Test format names and their sinks
+TEST(ScheduleSinkTest, Formats) {
+    EXPECT_EQ(ScheduleExport::parseFormat("csv"), ScheduleExport::Format::Csv);
+    EXPECT_EQ(ScheduleExport::parseFormat("binary"), ScheduleExport::Format::Binary);
+    EXPECT_THROW(ScheduleExport::parseFormat("xml"), std::invalid_argument);
+    EXPECT_EQ(ScheduleExport::parseFileFormat("ndjson"), ScheduleExport::Format::Ndjson);
+    EXPECT_THROW(ScheduleExport::parseFileFormat("ics"), std::invalid_argument);
+    EXPECT_THROW(ScheduleExport::parseFileFormat("null"), std::invalid_argument);
+    EXPECT_STREQ(ScheduleExport::extension(ScheduleExport::Format::Ndjson), "ndjson");
+
+    std::ostringstream out;
+    auto sink = ScheduleExport::makeSink(ScheduleExport::Format::Ndjson, out);
+    EXPECT_NE(dynamic_cast<NdjsonScheduleSink*>(sink.get()), nullptr);
+}
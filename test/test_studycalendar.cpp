@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include "../include/studycalendar.hpp"
+#include "FileException.hpp"
+#include <stdexcept>
+#include <vector>
+
+// Test day-number conversions against known dates, including leap days and the epoch
+TEST(StudyCalendarTest, CivilDateConversions) {
+    EXPECT_EQ(CivilDate({1970, 1, 1}).toDays(), 0);
+    EXPECT_EQ(CivilDate({2000, 3, 1}).toDays(), 11017);
+    EXPECT_EQ(CivilDate::fromDays(11016), CivilDate({2000, 2, 29}));
+    EXPECT_EQ(CivilDate::fromDays(-1), CivilDate({1969, 12, 31}));
+    EXPECT_EQ(CivilDate({2026, 12, 31}).plusDays(1), CivilDate({2027, 1, 1}));
+
+    for (long long days = -800000; days <= 800000; days += 97)
+        ASSERT_EQ(CivilDate::fromDays(days).toDays(), days);
+}
+
+// Test weekdays, 0 being Sunday
+TEST(StudyCalendarTest, Weekday) {
+    EXPECT_EQ(CivilDate({1970, 1, 1}).weekday(), 4);
+    EXPECT_EQ(CivilDate({1969, 12, 28}).weekday(), 0);
+    EXPECT_EQ(CivilDate({2026, 10, 19}).weekday(), 1);
+    EXPECT_EQ(CivilDate({2024, 2, 29}).weekday(), 4);
+}
+
+// Test date parsing and formatting
+TEST(StudyCalendarTest, ParseDate) {
+    EXPECT_EQ(CivilDate::parse("2024-02-29"), CivilDate({2024, 2, 29}));
+    EXPECT_EQ(CivilDate({2026, 3, 7}).toString(), "2026-03-07");
+    EXPECT_THROW(CivilDate::parse("2023-02-29"), std::invalid_argument);
+    EXPECT_THROW(CivilDate::parse("2026-13-01"), std::invalid_argument);
+    EXPECT_THROW(CivilDate::parse("2026-1-01"), std::invalid_argument);
+    EXPECT_THROW(CivilDate::parse("2026/01/01"), std::invalid_argument);
+}
+
+// Test that weekday and weekend hours follow real Saturdays and Sundays
+TEST(StudyCalendarTest, WeekdayWeekendCapacity) {
+    StudyCalendar calendar(3, 5);
+    // 2026-10-16 is a Friday, so day 1 is Saturday
+    std::vector<int> capacity = calendar.capacity(CivilDate{2026, 10, 16}, 9);
+    EXPECT_EQ(capacity, std::vector<int>({5, 5, 3, 3, 3, 3, 3, 5, 5}));
+}
+
+// Test holidays and exception days, exceptions taking precedence
+TEST(StudyCalendarTest, HolidaysAndExceptions) {
+    StudyCalendar calendar(2, 6);
+    calendar.addHoliday(CivilDate{2026, 12, 24});
+    calendar.addHoliday(CivilDate{2026, 12, 25});
+    calendar.setException(CivilDate{2026, 12, 25}, 1);
+    calendar.setException(CivilDate{2026, 12, 28}, 8);
+    calendar.addHoliday(CivilDate{2027, 6, 1}); // Beyond the horizon
+
+    EXPECT_EQ(calendar.hoursOn(CivilDate{2026, 12, 24}), 0);
+    EXPECT_EQ(calendar.hoursOn(CivilDate{2026, 12, 25}), 1);
+    // Day 1 is Wednesday 2026-12-23
+    std::vector<int> capacity = calendar.capacity(CivilDate{2026, 12, 22}, 7);
+    EXPECT_EQ(capacity, std::vector<int>({2, 0, 1, 6, 6, 8, 2}));
+
+    for (int day = 1; day <= 7; ++day)
+        EXPECT_EQ(capacity[day - 1], calendar.hoursOn(CivilDate{2026, 12, 22}.plusDays(day)));
+}
+
+// Test that the horizon is capped
+TEST(StudyCalendarTest, CapacityIsCapped) {
+    StudyCalendar calendar(1, 1);
+    EXPECT_EQ(calendar.capacity(CivilDate{2026, 1, 1}, 1 << 30).size(), StudyCalendar::MaxHorizonDays);
+    EXPECT_TRUE(calendar.capacity(CivilDate{2026, 1, 1}, -3).empty());
+}
+
+// Test loading a calendar from JSON
+TEST(StudyCalendarTest, FromJson) {
+    StudyCalendar calendar = StudyCalendar::fromJson(R"({
+        "weekly": {"monday": 3, "tuesday": 2, "saturday": 6},
+        "holidays": ["2026-10-20"],
+        "exceptions": {"2026-10-21": 4}
+    })");
+    // Day 1 is Monday 2026-10-19
+    EXPECT_EQ(calendar.capacity(CivilDate{2026, 10, 18}, 7), std::vector<int>({3, 0, 4, 0, 0, 6, 0}));
+
+    EXPECT_THROW(StudyCalendar::fromJson(R"({"weekly": {"funday": 3}})"), std::invalid_argument);
+    EXPECT_THROW(StudyCalendar::fromJson(R"({"holidays": ["tomorrow"]})"), std::invalid_argument);
+    EXPECT_THROW(StudyCalendar::fromJson(R"({"weekly": {"monday": "lots"}})"), std::invalid_argument);
+    EXPECT_THROW(StudyCalendar::fromJson("[1, 2]"), std::invalid_argument);
+    EXPECT_THROW(StudyCalendar::fromFile("Data/no_such_calendar.json"), FileException);
+}
+
+// Test slot granularity and study window settings
+TEST(StudyCalendarTest, StudyWindow) {
+    StudyCalendar calendar = StudyCalendar::fromJson(R"({
+        "weekly": {"monday": 3},
+        "slot_minutes": 15,
+        "window": {"start": "22:00", "end": "01:30"}
+    })");
+    TimeGrid grid = calendar.timeGrid(CivilDate{2026, 10, 18}, 2);
+    EXPECT_EQ(grid.slotMinutes(), 15);
+    EXPECT_EQ(grid.windowStart(), 22 * 60);
+    EXPECT_EQ(grid.slotsPerDay(), 14);
+    EXPECT_EQ(grid.freeHours(1), 3);
+
+    EXPECT_THROW(calendar.setSlotMinutes(25), std::invalid_argument);
+    EXPECT_THROW(StudyCalendar::fromJson(R"({"window": {"start": "18:00", "end": "19:30"}})"), std::invalid_argument);
+    EXPECT_THROW(StudyCalendar::fromJson(R"({"window": {"start": "6pm", "end": "10pm"}})"), std::invalid_argument);
+}
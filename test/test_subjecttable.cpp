@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+#include "../include/subjecttable.hpp"
+#include "../include/assignment.hpp"
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// Test that interning the same name twice yields the same id
+TEST(SubjectTableTest, InternIsIdempotent) {
+    SubjectTable table;
+
+    SubjectId math = table.intern("Math");
+    SubjectId art = table.intern("Art");
+
+    EXPECT_NE(math, art);
+    EXPECT_EQ(table.intern("Math"), math);
+    EXPECT_EQ(table.name(art), "Art");
+    EXPECT_EQ(table.size(), 2);
+}
+
+// Test lookup of unknown subjects
+TEST(SubjectTableTest, FindUnknown) {
+    SubjectTable table;
+    table.intern("Math");
+
+    EXPECT_EQ(table.find("History"), SubjectTable::InvalidId);
+    EXPECT_EQ(table.size(), 1);
+}
+
+// Test that assignments share the interned subject
+TEST(SubjectTableTest, AssignmentsShareSubjectId) {
+    Assignment a("Chemistry", "Lab 1", 3, 2, 5.0f, 3, false, 1);
+    Assignment b("Chemistry", "Lab 2", 5, 2, 5.0f, 3, false, 1);
+
+    EXPECT_EQ(a.getSubjectId(), b.getSubjectId());
+    EXPECT_EQ(a.getSubject(), "Chemistry");
+    EXPECT_EQ(&a.getSubject(), &b.getSubject());
+}
+
+// Test that names read while another thread interns are complete and stay put
+TEST(SubjectTableTest, ReadsWhileInterning) {
+    SubjectTable table;
+    const SubjectId first = table.intern("Subject 0");
+    const std::string* firstName = &table.name(first);
+
+    const int count = static_cast<int>(SubjectTable::ChunkSize) * 8;
+    std::thread writer([&table, count] {
+        for (int i = 1; i < count; ++i)
+            table.intern("Subject " + std::to_string(i));
+    });
+    std::size_t checked = 0;
+    while (checked < static_cast<std::size_t>(count)) {
+        std::size_t size = table.size();
+        for (; checked < size; ++checked)
+            ASSERT_EQ(table.name(static_cast<SubjectId>(checked)), "Subject " + std::to_string(checked));
+    }
+    writer.join();
+
+    EXPECT_EQ(&table.name(first), firstName);
+    EXPECT_EQ(table.find("Subject 1000"), 1000u);
+    EXPECT_THROW(table.name(static_cast<SubjectId>(count)), std::out_of_range);
+}
@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+#include "../include/timegrid.hpp"
+#include "../include/bitops.hpp"
+#include <stdexcept>
+#include <vector>
+
+// Test the portable bit scans
+TEST(TimeGridTest, BitOps) {
+    EXPECT_EQ(BitOps::countTrailingZeros(1), 0);
+    EXPECT_EQ(BitOps::countTrailingZeros(0x8000000000000000ull), 63);
+    EXPECT_EQ(BitOps::countTrailingZeros(0x50), 4);
+    EXPECT_EQ(BitOps::popCount(0), 0);
+    EXPECT_EQ(BitOps::popCount(~0ull), 64);
+    EXPECT_EQ(BitOps::popCount(0xF0F0), 8);
+}
+
+// Test that a fresh grid is free over the whole window, across word boundaries
+TEST(TimeGridTest, EmptyGrid) {
+    TimeGrid grid(3, 15, 18 * 60, 24 * 60);
+    EXPECT_EQ(grid.slotsPerDay(), 96);
+    EXPECT_EQ(grid.slotsPerHour(), 4);
+    EXPECT_EQ(grid.freeSlots(1), 96);
+    EXPECT_EQ(grid.freeHours(2), 24);
+    EXPECT_EQ(grid.nextFree(1, 70), 70);
+    EXPECT_EQ(grid.nextBusy(1, 0), 96);
+    EXPECT_FALSE(grid.isFree(1, 96));
+    EXPECT_EQ(grid.freeSlots(4), 0);
+}
+
+// Test blocking ranges and scanning for free and busy slots
+TEST(TimeGridTest, BlockAndScan) {
+    TimeGrid grid(2, 5, 8 * 60, 16 * 60); // 192 slots, three words
+    grid.block(1, 10, 120);
+    EXPECT_EQ(grid.freeSlots(1), 72);
+    EXPECT_EQ(grid.freeSlots(2), 192);
+    EXPECT_EQ(grid.nextBusy(1, 0), 10);
+    EXPECT_EQ(grid.nextFree(1, 10), 130);
+    EXPECT_EQ(grid.nextFree(1, 129), 130);
+    EXPECT_TRUE(grid.isFree(1, 9));
+    EXPECT_FALSE(grid.isFree(1, 64));
+
+    // Ranges are clipped to the window
+    grid.block(2, -5, 10);
+    grid.block(2, 190, 50);
+    EXPECT_EQ(grid.freeSlots(2), 192 - 5 - 2);
+    EXPECT_EQ(grid.nextFree(2, 0), 5);
+    EXPECT_EQ(grid.nextBusy(2, 5), 190);
+}
+
+// Test that taking time fills the earliest free slots, split around busy ranges
+TEST(TimeGridTest, TakeEarliestFreeSlots) {
+    TimeGrid grid(1, 30, 18 * 60, 4 * 60);
+    grid.block(1, 1, 2); // 18:30-19:30 busy
+
+    std::vector<SlotRun> first = grid.take(1, 2);
+    ASSERT_EQ(first.size(), 2);
+    EXPECT_EQ(first[0].firstSlot, 0);
+    EXPECT_EQ(first[0].length, 1);
+    EXPECT_EQ(first[1].firstSlot, 3);
+    EXPECT_EQ(first[1].length, 1);
+    EXPECT_EQ(grid.minuteOf(3), 19 * 60 + 30);
+
+    std::vector<SlotRun> second = grid.take(1, 10);
+    ASSERT_EQ(second.size(), 1);
+    EXPECT_EQ(second[0].firstSlot, 4);
+    EXPECT_EQ(second[0].length, 4);
+    EXPECT_EQ(grid.freeSlots(1), 0);
+    EXPECT_TRUE(grid.take(1, 1).empty());
+}
+
+// Test that invalid granularities and windows are rejected
+TEST(TimeGridTest, InvalidSettings) {
+    EXPECT_THROW(TimeGrid(1, 45), std::invalid_argument);
+    EXPECT_THROW(TimeGrid(1, 0), std::invalid_argument);
+    EXPECT_THROW(TimeGrid(1, 30, 24 * 60), std::invalid_argument);
+    EXPECT_THROW(TimeGrid(1, 60, 18 * 60, 90), std::invalid_argument);
+    EXPECT_THROW(TimeGrid(1, 60, 18 * 60, 25 * 60), std::invalid_argument);
+}
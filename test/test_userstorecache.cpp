@@ -0,0 +1,160 @@
+#include "gtest/gtest.h"
+#include "../include/userstorecache.hpp"
+#include "../include/planner.hpp"
+#include "FileException.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+// Cache tests work on their own user files under Data/
+class UserStoreCacheTest : public ::testing::Test {
+protected:
+    const std::string users[3] = {"cache_user_a", "cache_user_b", "cache_user_c"};
+
+    void SetUp() override {
+        std::filesystem::create_directory("Data");
+        for (const auto& user : users)
+            std::remove(("Data/" + user + ".json").c_str());
+    }
+
+    void TearDown() override {
+        for (const auto& user : users)
+            std::remove(("Data/" + user + ".json").c_str());
+    }
+
+    static void addAssignment(AssignmentStore& store, const std::string& name) {
+        store.add(std::make_shared<Assignment>("Math", name, 5, 3, 10.0f, 2, false, 1));
+    }
+};
+
+// Test hit and miss counting and LRU reuse
+TEST_F(UserStoreCacheTest, HitsAndMisses) {
+    UserStoreCache cache;
+
+    cache.get(users[0]);
+    cache.get(users[0]);
+    cache.get(users[1]);
+
+    EXPECT_EQ(cache.stats().misses, 2);
+    EXPECT_EQ(cache.stats().hits, 1);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_GT(cache.bytesUsed(), 0);
+}
+
+// Test that exceeding the budget evicts the least recently used store and saves it if dirty
+TEST_F(UserStoreCacheTest, EvictionSavesDirtyStore) {
+    UserStoreCache probe;
+    std::size_t emptyStore = probe.get(users[0]).memoryUsage();
+
+    // Room for about two empty stores
+    UserStoreCache cache(emptyStore * 2 + emptyStore / 2);
+
+    addAssignment(cache.get(users[0]), "Homework");
+    cache.markDirty(users[0]);
+    EXPECT_TRUE(cache.isDirty(users[0]));
+
+    cache.get(users[1]);
+    cache.get(users[2]);
+
+    EXPECT_FALSE(cache.contains(users[0]));
+    EXPECT_GE(cache.stats().evictions, 1);
+    EXPECT_EQ(cache.stats().saves, 1);
+
+    auto saved = Planner::loadFromFile("Data/" + users[0] + ".json");
+    ASSERT_EQ(saved.size(), 1);
+    EXPECT_EQ(saved[0]->getName(), "Homework");
+
+    // Reloading after eviction is a miss that reads the saved file
+    EXPECT_EQ(cache.get(users[0]).size(), 1);
+}
+
+// Test that destroying the cache writes back dirty stores
+TEST_F(UserStoreCacheTest, FlushOnDestruction) {
+    {
+        UserStoreCache cache;
+        addAssignment(cache.get(users[2]), "Essay");
+        cache.markDirty(users[2]);
+    }
+
+    auto saved = Planner::loadFromFile("Data/" + users[2] + ".json");
+    ASSERT_EQ(saved.size(), 1);
+    EXPECT_EQ(saved[0]->getName(), "Essay");
+}
+
+// Test that a failed write keeps the store dirty and cached until a later save succeeds
+TEST_F(UserStoreCacheTest, FailedSaveKeepsStoreDirty) {
+    const std::string directory = "Data/cache_missing_dir";
+    std::filesystem::remove_all(directory);
+    {
+        UserStoreCache probe;
+        std::size_t emptyStore = probe.get(users[0]).memoryUsage();
+
+        UserStoreCache cache(emptyStore + emptyStore / 2, directory);
+        addAssignment(cache.get(users[0]), "Homework");
+        cache.markDirty(users[0]);
+        cache.flush();
+        EXPECT_TRUE(cache.isDirty(users[0]));
+        EXPECT_EQ(cache.stats().failedSaves, 1);
+
+        // Over budget, but the unsaved store is not evicted
+        cache.get(users[1]);
+        EXPECT_TRUE(cache.contains(users[0]));
+        EXPECT_EQ(cache.stats().evictions, 0);
+
+        std::filesystem::create_directory(directory);
+        cache.flush();
+        EXPECT_FALSE(cache.isDirty(users[0]));
+        EXPECT_EQ(cache.stats().saves, 1);
+    }
+    EXPECT_EQ(Planner::loadFromFile(directory + "/" + users[0] + ".json").size(), 1);
+    std::filesystem::remove_all(directory);
+}
+
+// Test that stores are written back after enough changes or once they have aged
+TEST_F(UserStoreCacheTest, BoundedWriteBack) {
+    UserStoreCache cache;
+    cache.setWriteBack(3, std::chrono::hours(1));
+
+    AssignmentStore& store = cache.get(users[0]);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_FALSE(std::filesystem::exists("Data/" + users[0] + ".json"));
+        addAssignment(store, "Task " + std::to_string(i));
+        cache.markDirty(users[0]);
+    }
+    EXPECT_FALSE(cache.isDirty(users[0]));
+    EXPECT_EQ(Planner::loadFromFile("Data/" + users[0] + ".json").size(), 3);
+
+    addAssignment(store, "Task 3");
+    cache.markDirty(users[0]);
+    cache.flushExpired();
+    EXPECT_TRUE(cache.isDirty(users[0]));
+
+    cache.setWriteBack(3, std::chrono::milliseconds(0));
+    cache.flushExpired();
+    EXPECT_FALSE(cache.isDirty(users[0]));
+    EXPECT_EQ(Planner::loadFromFile("Data/" + users[0] + ".json").size(), 4);
+}
+
+// Test that a user file that fails to parse is neither cached nor overwritten
+TEST_F(UserStoreCacheTest, UnreadableFileIsNotCached) {
+    const std::string filename = "Data/" + users[0] + ".json";
+    {
+        std::ofstream file(filename);
+        file << "[{\"subject\": \"Math\", truncated";
+    }
+
+    {
+        UserStoreCache cache;
+        EXPECT_THROW(cache.get(users[0]), FileException);
+        EXPECT_FALSE(cache.contains(users[0]));
+        cache.flush();
+    }
+
+    std::ifstream file(filename);
+    std::string kept((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(kept, "[{\"subject\": \"Math\", truncated");
+}